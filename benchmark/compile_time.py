@@ -0,0 +1,282 @@
+"""
+Compile time benchmark for reflection.hpp.
+
+Generates translation units of synthetic reflectable structs and measures how long the
+compiler takes to preprocess, parse and compile them, and how large the object file is.
+
+Two sweeps are run:
+- fields	: structs with 1 to 256 reflected data members.
+- nesting	: structs nested 1 to 8 levels deep, every level holding 4 data members and the next level.
+
+Every translation unit is measured twice, once only declaring the structs (cost of REFLECTABLE
+itself) and once also instantiating visit on const and non-const objects and serialize
+(cost of the templates working with the metadata). Expansion and instantiation cost should
+grow linearly, so the time per data member should stay roughly flat.
+
+Usage:
+	python benchmark/compile_time.py [--compiler g++] [--repeat 5] [--trace DIRECTORY]
+	python benchmark/compile_time.py --save baseline.json
+	python benchmark/compile_time.py --compare baseline.json --tolerance 0.15
+
+--trace keeps per translation unit compiler reports in DIRECTORY: -ftime-trace for Clang,
+-ftime-report for GCC and /d1reportTime for MSVC.
+--compare exits with a non zero status if any compile time grew by more than the tolerance.
+
+Works with GCC, Clang (and clang-cl) and MSVC. For MSVC run it from a developer command prompt with --compiler cl.
+"""
+
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+REPOSITORY = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+FIELD_COUNTS = [1, 8, 16, 32, 64, 128, 256]
+NESTING_DEPTHS = [1, 2, 4, 8]
+FIELDS_PER_LEVEL = 4
+
+
+def is_msvc(compiler):
+	return os.path.splitext(os.path.basename(compiler))[0].lower() in ("cl", "clang-cl")
+
+
+def is_clang(compiler):
+	return "clang" in os.path.basename(compiler).lower()
+
+
+def preprocess_command(compiler, source):
+	if is_msvc(compiler):
+		return [compiler, "/nologo", "/std:c++20", "/Zc:preprocessor", "/I", REPOSITORY, "/EP", source]
+	return [compiler, "-std=c++20", "-I", REPOSITORY, "-E", "-P", source, "-o", os.devnull]
+
+
+def parse_command(compiler, source):
+	if is_msvc(compiler):
+		return [compiler, "/nologo", "/std:c++20", "/Zc:preprocessor", "/I", REPOSITORY, "/Zs", source]
+	return [compiler, "-std=c++20", "-I", REPOSITORY, "-fsyntax-only", source]
+
+
+def compile_command(compiler, source, output, trace_directory):
+	if is_msvc(compiler):
+		command = [compiler, "/nologo", "/std:c++20", "/Zc:preprocessor", "/O2", "/I", REPOSITORY, "/c", source, "/Fo" + output]
+		if trace_directory:
+			command += ["/Bt+", "/d1reportTime"]
+		return command
+
+	command = [compiler, "-std=c++20", "-O2", "-I", REPOSITORY, "-c", source, "-o", output]
+	if trace_directory:
+		if is_clang(compiler):
+			command += ["-ftime-trace", "-ftime-trace-granularity=50"]
+		else:
+			command += ["-ftime-report"]
+	return command
+
+
+def generate_flat(struct_count, field_count):
+	members = "".join(f"\tint field{i} = {i};\n" for i in range(field_count))
+	names = ", ".join(f"field{i}" for i in range(field_count))
+	structs = "".join(f"struct Generated{j} {{\n{members}\n\tREFLECTABLE({names})\n}};\n\n" for j in range(struct_count))
+	return structs, [f"Generated{j}" for j in range(struct_count)], field_count
+
+
+def generate_nested(struct_count, depth):
+	source = ""
+	outermost = []
+
+	for j in range(struct_count):
+		for level in range(depth):
+			name = f"Generated{j}Level{level}"
+			members = "".join(f"\tfloat field{i} = {i};\n" for i in range(FIELDS_PER_LEVEL))
+			names = [f"field{i}" for i in range(FIELDS_PER_LEVEL)]
+
+			if level > 0:
+				members += f"\tGenerated{j}Level{level - 1} inner {{}};\n"
+				names.append("inner")
+
+			source += f"struct {name} {{\n{members}\n\tREFLECTABLE({', '.join(names)})\n}};\n\n"
+		outermost.append(f"Generated{j}Level{depth - 1}")
+
+	return source, outermost, depth * FIELDS_PER_LEVEL
+
+
+def instantiate(types):
+	# one function per type so nothing gets folded away, const and non const objects instantiate separate visit chains.
+	body = "\n#include <vector>\n\n"
+	for index, name in enumerate(types):
+		body += (
+			f"int use{index}(std::vector<std::byte>& buffer) {{\n"
+			f"\t{name} object {{}};\n"
+			f"\t{name} const constObject {{}};\n"
+			f"\tint count = 0;\n"
+			f"\treflection::visit([&](auto fieldData) {{ count += static_cast<int>(fieldData.get()); }}, object);\n"
+			f"\treflection::visit([&](auto fieldData) {{ count += static_cast<int>(fieldData.get()); }}, constObject);\n"
+			f"\treflection::serialize(object, buffer);\n"
+			f"\treturn count + static_cast<int>(reflection::deserialize(buffer, object));\n"
+			f"}}\n\n"
+		)
+	return body
+
+
+def write_source(directory, name, body):
+	path = os.path.join(directory, name)
+	with open(path, "w") as file:
+		file.write('#include "reflection.hpp"\n\n' + body)
+	return path
+
+
+def run(command, trace_file=None):
+	start = time.perf_counter()
+	result = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True)
+	elapsed = time.perf_counter() - start
+
+	if result.returncode != 0:
+		sys.exit(f"Compilation failed:\n{' '.join(command)}\n{result.stderr}{result.stdout}")
+
+	if trace_file:
+		with open(trace_file, "w") as file:
+			file.write(result.stdout + result.stderr)
+
+	return elapsed
+
+
+def measure(command, repeat):
+	# the fastest run is the one least disturbed by the rest of the system, the spread shows how disturbed the others were.
+	times = [run(command) * 1000.0 for _ in range(repeat)]
+	return min(times), max(times) - min(times)
+
+
+class Benchmark:
+	def __init__(self, arguments, directory):
+		self.arguments = arguments
+		self.directory = directory
+		self.results = {}
+		self.noisy = []
+
+		# cost of including the header alone, subtracted from every measurement.
+		empty = write_source(directory, "empty.cpp", "")
+		self.base, self.base_spread = self.measure_source(empty, "empty", keep_trace=False)
+
+	def measure_source(self, source, label, keep_trace=True):
+		compiler = self.arguments.compiler
+		repeat = self.arguments.repeat
+		output = os.path.join(self.directory, label + (".obj" if is_msvc(compiler) else ".o"))
+
+		commands = {
+			"preprocess": preprocess_command(compiler, source),
+			"parse": parse_command(compiler, source),
+			"compile": compile_command(compiler, source, output, None),
+		}
+
+		timings, spread = {}, {}
+		for phase, command in commands.items():
+			timings[phase], spread[phase] = measure(command, repeat)
+		timings["object"] = os.path.getsize(output)
+		spread["object"] = 0
+
+		trace_directory = self.arguments.trace
+		if keep_trace and trace_directory:
+			os.makedirs(trace_directory, exist_ok=True)
+			run(compile_command(compiler, source, output, trace_directory), os.path.join(trace_directory, label + ".txt"))
+
+			# clang writes its trace next to the object file.
+			clang_trace = os.path.splitext(output)[0] + ".json"
+			if os.path.exists(clang_trace):
+				shutil.move(clang_trace, os.path.join(trace_directory, label + ".json"))
+
+		return timings, spread
+
+	def run_case(self, label, source, types, fields_per_struct):
+		structs = self.arguments.structs
+		print(f"{label:<24}", end="", flush=True)
+
+		for mode in ("declare", "instantiate"):
+			body = source + (instantiate(types) if mode == "instantiate" else "")
+			path = write_source(self.directory, f"{label}_{mode}.cpp", body)
+			timings, spread = self.measure_source(path, f"{label}_{mode}")
+
+			# with few repeats the header cost can be measured higher than the whole translation unit, which isn't a negative cost.
+			result = {key: max(timings[key] - self.base[key], 0) for key in timings}
+			self.results[f"{label}/{mode}"] = result
+
+			if timings["compile"] - self.base["compile"] < max(spread["compile"], self.base_spread["compile"]):
+				self.noisy.append(f"{label}/{mode}")
+
+			per_field = result["compile"] * 1000.0 / (fields_per_struct * structs)
+			print(f" {result['preprocess']:>9.1f} {result['parse']:>9.1f} {result['compile']:>9.1f} {per_field:>8.1f} {result['object'] / 1024:>8.1f}", end="", flush=True)
+		print()
+
+	def run(self):
+		structs = self.arguments.structs
+
+		print(f"{structs} structs per translation unit, header cost subtracted. Times in ms, per field in us, object size in KiB.")
+		print(f"{'':<24} {'declare':^46} {'declare + visit + serialize':^46}")
+		print(f"{'case':<24}" + f" {'prep':>9} {'parse':>9} {'compile':>9} {'/field':>8} {'object':>8}" * 2)
+
+		for field_count in FIELD_COUNTS:
+			self.run_case(f"fields_{field_count}", *generate_flat(structs, field_count))
+
+		for depth in NESTING_DEPTHS:
+			self.run_case(f"nesting_{depth}", *generate_nested(structs, depth))
+
+		if self.noisy:
+			print(f"\nWarning: the compile times of {', '.join(self.noisy)} are within measurement noise and were clamped to 0 where negative, "
+				f"use a higher --repeat or more --structs for a steadier signal.", file=sys.stderr)
+
+		return self.results
+
+
+def compare(results, baseline_path, tolerance):
+	with open(baseline_path) as file:
+		baseline = json.load(file)
+
+	regressions = []
+	for case, timings in results.items():
+		if case not in baseline:
+			continue
+
+		before = baseline[case]["compile"]
+		after = timings["compile"]
+
+		# ignore cases too small to measure reliably.
+		if before > 20.0 and after > before * (1.0 + tolerance):
+			regressions.append(f"{case}: {before:.1f} ms -> {after:.1f} ms")
+
+	if regressions:
+		print("\nCompile time regressions:\n" + "\n".join(regressions))
+		return 1
+
+	print(f"\nNo compile time regressions beyond {tolerance:.0%} of {baseline_path}.")
+	return 0
+
+
+def main():
+	parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+	parser.add_argument("--compiler", default=os.environ.get("CXX", "g++"))
+	parser.add_argument("--repeat", type=int, default=5, help="Runs per measurement, the fastest is reported.")
+	parser.add_argument("--structs", type=int, default=20, help="Structs per translation unit, more structs give a steadier signal.")
+	parser.add_argument("--trace", metavar="DIRECTORY", help="Keep compiler time reports for every translation unit in this directory.")
+	parser.add_argument("--save", metavar="FILE", help="Write the results as json, to be used with --compare later.")
+	parser.add_argument("--compare", metavar="FILE", help="Compare the results against a file written by --save.")
+	parser.add_argument("--tolerance", type=float, default=0.15, help="Allowed relative compile time growth for --compare.")
+	arguments = parser.parse_args()
+
+	if not shutil.which(arguments.compiler):
+		sys.exit(f"Compiler {arguments.compiler} not found.")
+
+	with tempfile.TemporaryDirectory() as directory:
+		results = Benchmark(arguments, directory).run()
+
+	if arguments.save:
+		with open(arguments.save, "w") as file:
+			json.dump(results, file, indent=4)
+
+	if arguments.compare:
+		sys.exit(compare(results, arguments.compare, arguments.tolerance))
+
+
+if __name__ == "__main__":
+	main()
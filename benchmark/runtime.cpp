@@ -0,0 +1,320 @@
+/*!*****************************************************************************************
+	Runtime throughput benchmark, comparing the reflection library against hand written
+	equivalents for the same work. Reports nanoseconds per object, if reflection is truly
+	zero overhead the ratio column should stay close to 1.
+
+	Self contained, build with optimisations from the repository root:
+		g++ -std=c++20 -O2 -I. benchmark/runtime.cpp -o runtime
+		clang++ -std=c++20 -O2 -I. benchmark/runtime.cpp -o runtime
+		cl /std:c++20 /Zc:preprocessor /O2 /EHsc /I. benchmark\runtime.cpp
+
+	Pass a number as first argument to change the number of passes over the objects (default 2000).
+*******************************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+#include "reflection.hpp"
+
+struct Point {
+	float x = 0;
+	float y = 0;
+
+	REFLECTABLE(x, y)
+};
+
+struct Points {
+	Point pt1 {};
+	Point pt2 {};
+	Point pt3 {};
+
+	REFLECTABLE(pt1, pt2, pt3)
+};
+
+struct ManyPoints {
+	Points points1 { {6.0f, 5.0f}, {4.0f, 3.0f}, {2.0f, 1.0f} };
+	Point pt { 5.f, 5.f };
+
+	int x = 10;
+	int y = 20;
+
+	Points points2{ {-16.0f, -15.0f}, {-14.0f, -13.0f}, {-12.0f, -11.0f} };
+
+	REFLECTABLE(points1, pt, x, y, points2)
+};
+
+// Large synthetic type with mixed data member types and padding between some of them.
+struct Large {
+	int a0 = 0; float b0 = 1; double c0 = 2; char d0 = 3; int a1 = 4; float b1 = 5; double c1 = 6; char d1 = 7;
+	int a2 = 0; float b2 = 1; double c2 = 2; char d2 = 3; int a3 = 4; float b3 = 5; double c3 = 6; char d3 = 7;
+	int a4 = 0; float b4 = 1; double c4 = 2; char d4 = 3; int a5 = 4; float b5 = 5; double c5 = 6; char d5 = 7;
+	int a6 = 0; float b6 = 1; double c6 = 2; char d6 = 3; int a7 = 4; float b7 = 5; double c7 = 6; char d7 = 7;
+	int a8 = 0; float b8 = 1; double c8 = 2; char d8 = 3; int a9 = 4; float b9 = 5; double c9 = 6; char d9 = 7;
+	int a10 = 0; float b10 = 1; double c10 = 2; char d10 = 3; int a11 = 4; float b11 = 5; double c11 = 6; char d11 = 7;
+	int a12 = 0; float b12 = 1; double c12 = 2; char d12 = 3; int a13 = 4; float b13 = 5; double c13 = 6; char d13 = 7;
+	int a14 = 0; float b14 = 1; double c14 = 2; char d14 = 3; int a15 = 4; float b15 = 5; double c15 = 6; char d15 = 7;
+
+	REFLECTABLE(
+		a0, b0, c0, d0, a1, b1, c1, d1, a2, b2, c2, d2, a3, b3, c3, d3,
+		a4, b4, c4, d4, a5, b5, c5, d5, a6, b6, c6, d6, a7, b7, c7, d7,
+		a8, b8, c8, d8, a9, b9, c9, d9, a10, b10, c10, d10, a11, b11, c11, d11,
+		a12, b12, c12, d12, a13, b13, c13, d13, a14, b14, c14, d14, a15, b15, c15, d15
+	)
+};
+
+#define LARGE_FIELDS(X) \
+	X(a0) X(b0) X(c0) X(d0) X(a1) X(b1) X(c1) X(d1) X(a2) X(b2) X(c2) X(d2) X(a3) X(b3) X(c3) X(d3) \
+	X(a4) X(b4) X(c4) X(d4) X(a5) X(b5) X(c5) X(d5) X(a6) X(b6) X(c6) X(d6) X(a7) X(b7) X(c7) X(d7) \
+	X(a8) X(b8) X(c8) X(d8) X(a9) X(b9) X(c9) X(d9) X(a10) X(b10) X(c10) X(d10) X(a11) X(b11) X(c11) X(d11) \
+	X(a12) X(b12) X(c12) X(d12) X(a13) X(b13) X(c13) X(d13) X(a14) X(b14) X(c14) X(d14) X(a15) X(b15) X(c15) X(d15)
+
+/*!========================================================================
+	Hand written equivalents, written data member by data member like the
+	code reflection is meant to replace.
+========================================================================*/
+namespace handwritten {
+	double sum(Point const& pt)			{ return double(pt.x) + pt.y; }
+	double sum(Points const& pts)		{ return sum(pts.pt1) + sum(pts.pt2) + sum(pts.pt3); }
+	double sum(ManyPoints const& pts)	{ return sum(pts.points1) + sum(pts.pt) + pts.x + pts.y + sum(pts.points2); }
+
+	double sum(Large const& large) {
+		double total = 0;
+		#define ADD(member) total += large.member;
+		LARGE_FIELDS(ADD)
+		#undef ADD
+		return total;
+	}
+
+	template <typename T>
+	void write(std::byte*& destination, T const& value) {
+		std::memcpy(destination, &value, sizeof(T));
+		destination += sizeof(T);
+	}
+
+	template <typename T>
+	void read(std::byte const*& source, T& value) {
+		std::memcpy(&value, source, sizeof(T));
+		source += sizeof(T);
+	}
+
+	// Bytes written for an object, its data members without padding.
+	constexpr std::size_t packedSize(Point const&)			{ return sizeof(Point::x) + sizeof(Point::y); }
+	constexpr std::size_t packedSize(Points const&)			{ return 3 * packedSize(Point {}); }
+	constexpr std::size_t packedSize(ManyPoints const&)		{ return 2 * packedSize(Points {}) + packedSize(Point {}) + sizeof(ManyPoints::x) + sizeof(ManyPoints::y); }
+
+	constexpr std::size_t packedSize(Large const&) {
+		#define SIZE(member) + sizeof(Large::member)
+		return 0 LARGE_FIELDS(SIZE);
+		#undef SIZE
+	}
+
+	void serialize(Point const& pt, std::byte*& destination)			{ write(destination, pt.x); write(destination, pt.y); }
+	void serialize(Points const& pts, std::byte*& destination)			{ serialize(pts.pt1, destination); serialize(pts.pt2, destination); serialize(pts.pt3, destination); }
+	void serialize(ManyPoints const& pts, std::byte*& destination)		{ serialize(pts.points1, destination); serialize(pts.pt, destination); write(destination, pts.x); write(destination, pts.y); serialize(pts.points2, destination); }
+
+	void serialize(Large const& large, std::byte*& destination) {
+		#define WRITE(member) write(destination, large.member);
+		LARGE_FIELDS(WRITE)
+		#undef WRITE
+	}
+
+	// Grows buffer once for the whole object, then copies the data members into it.
+	template <typename T>
+	void serialize(T const& value, std::vector<std::byte>& buffer) {
+		std::size_t const size = buffer.size();
+		buffer.resize(size + packedSize(value));
+
+		std::byte* destination = buffer.data() + size;
+		serialize(value, destination);
+	}
+
+	void deserialize(std::byte const*& source, Point& pt)			{ read(source, pt.x); read(source, pt.y); }
+	void deserialize(std::byte const*& source, Points& pts)			{ deserialize(source, pts.pt1); deserialize(source, pts.pt2); deserialize(source, pts.pt3); }
+	void deserialize(std::byte const*& source, ManyPoints& pts)		{ deserialize(source, pts.points1); deserialize(source, pts.pt); read(source, pts.x); read(source, pts.y); deserialize(source, pts.points2); }
+
+	void deserialize(std::byte const*& source, Large& large) {
+		#define READ(member) read(source, large.member);
+		LARGE_FIELDS(READ)
+		#undef READ
+	}
+
+	void prettyPrint(Point const& pt, std::ostream& stream) {
+		stream << "{\n    x = " << pt.x << ",\n    y = " << pt.y << ",\n}\n";
+	}
+
+	void prettyPrint(ManyPoints const& pts, std::ostream& stream) {
+		auto point = [&](Point const& pt, char const* indent) {
+			stream << indent << "{\n" << indent << "    x = " << pt.x << ",\n" << indent << "    y = " << pt.y << ",\n" << indent << "},\n";
+		};
+		auto points = [&](Points const& p) {
+			stream << "    {\n";
+			point(p.pt1, "        ");
+			point(p.pt2, "        ");
+			point(p.pt3, "        ");
+			stream << "    },\n";
+		};
+
+		stream << "{\n";
+		points(pts.points1);
+		point(pts.pt, "    ");
+		stream << "    x = " << pts.x << ",\n    y = " << pts.y << ",\n";
+		points(pts.points2);
+		stream << "}\n";
+	}
+}
+
+/*!========================================================================
+	Harness
+========================================================================*/
+// Keeps the optimizer from discarding a computed value.
+template <typename T>
+void doNotOptimize(T const& value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+	static volatile char sink;
+	sink = *reinterpret_cast<char const volatile*>(&value);
+#else
+	asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+// Discards everything written to it, so printing benchmarks measure formatting and not the terminal.
+class NullBuffer : public std::streambuf {
+protected:
+	int overflow(int character) override { return character; }
+	std::streamsize xsputn(char const*, std::streamsize count) override { return count; }
+};
+
+constexpr std::size_t objectCount = 1024;
+constexpr std::size_t repetitions = 5;
+
+// Runs func over every object, passes times, and returns the nanoseconds spent per object.
+// The passes are split into repetitions timed separately, the fastest one is kept since noise only adds time.
+template <typename T, typename Functor>
+double measure(std::vector<T>& objects, std::size_t passes, Functor&& func) {
+	// warm up caches and branch predictors first.
+	for (T& object : objects) {
+		func(object);
+	}
+
+	std::size_t const passesPerRepetition = std::max<std::size_t>(passes / repetitions, 1);
+	double fastest = std::numeric_limits<double>::infinity();
+
+	for (std::size_t repetition = 0; repetition < repetitions; ++repetition) {
+		auto const start = std::chrono::steady_clock::now();
+
+		for (std::size_t pass = 0; pass < passesPerRepetition; ++pass) {
+			for (T& object : objects) {
+				func(object);
+			}
+		}
+
+		std::chrono::duration<double, std::nano> const elapsed = std::chrono::steady_clock::now() - start;
+		fastest = std::min(fastest, elapsed.count() / double(passesPerRepetition * objects.size()));
+	}
+
+	return fastest;
+}
+
+void report(char const* name, double reflected, double handwritten) {
+	std::printf("%-28s %12.2f %12.2f %8.2fx\n", name, reflected, handwritten, reflected / handwritten);
+}
+
+template <typename T>
+void benchmarkType(char const* typeName, std::size_t passes) {
+	std::vector<T> objects(objectCount);
+	std::vector<std::byte> buffer;
+	char name[64];
+
+	// visit, summing every data member.
+	double const visitReflected = measure(objects, passes, [](T const& object) {
+		double total = 0;
+		reflection::visit([&](auto fieldData) { total += fieldData.get(); }, object);
+		doNotOptimize(total);
+	});
+	double const visitHandwritten = measure(objects, passes, [](T const& object) {
+		doNotOptimize(handwritten::sum(object));
+	});
+
+	std::snprintf(name, sizeof(name), "%s visit", typeName);
+	report(name, visitReflected, visitHandwritten);
+
+	// serialize into a reused buffer.
+	double const serializeReflected = measure(objects, passes, [&](T const& object) {
+		buffer.clear();
+		reflection::serialize(object, buffer);
+		doNotOptimize(buffer.data());
+	});
+	double const serializeHandwritten = measure(objects, passes, [&](T const& object) {
+		buffer.clear();
+		handwritten::serialize(object, buffer);
+		doNotOptimize(buffer.data());
+	});
+
+	std::snprintf(name, sizeof(name), "%s serialize", typeName);
+	report(name, serializeReflected, serializeHandwritten);
+
+	// deserialize from bytes written once.
+	buffer.clear();
+	reflection::serialize(T{}, buffer);
+
+	double const deserializeReflected = measure(objects, passes, [&](T& object) {
+		doNotOptimize(reflection::deserialize(buffer, object));
+		doNotOptimize(object);
+	});
+	double const deserializeHandwritten = measure(objects, passes, [&](T& object) {
+		std::byte const* source = buffer.data();
+		handwritten::deserialize(source, object);
+		doNotOptimize(source);
+		doNotOptimize(object);
+	});
+
+	std::snprintf(name, sizeof(name), "%s deserialize", typeName);
+	report(name, deserializeReflected, deserializeHandwritten);
+}
+
+template <typename T>
+void benchmarkPrettyPrint(char const* typeName, std::size_t passes) {
+	std::vector<T> objects(objectCount);
+	NullBuffer nullBuffer;
+	std::ostream nullStream { &nullBuffer };
+
+	// prettyPrint writes to std::cout, point it to the null buffer while measuring.
+	std::streambuf* const coutBuffer = std::cout.rdbuf(&nullBuffer);
+
+	double const reflected = measure(objects, passes, [](T const& object) {
+		reflection::prettyPrint(object);
+	});
+	double const written = measure(objects, passes, [&](T const& object) {
+		handwritten::prettyPrint(object, nullStream);
+	});
+
+	std::cout.rdbuf(coutBuffer);
+
+	char name[64];
+	std::snprintf(name, sizeof(name), "%s prettyPrint", typeName);
+	report(name, reflected, written);
+}
+
+int main(int argc, char** argv) {
+	std::size_t const passes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+
+	std::printf("%zu objects, %zu passes\n", objectCount, passes);
+	std::printf("%-28s %12s %12s %9s\n", "benchmark", "reflection", "handwritten", "ratio");
+	std::printf("%-28s %12s %12s\n", "", "ns/object", "ns/object");
+
+	benchmarkType<Point>("Point", passes);
+	benchmarkType<Points>("Points", passes);
+	benchmarkType<ManyPoints>("ManyPoints", passes);
+	benchmarkType<Large>("Large", passes / 4);
+
+	// printing is orders of magnitude slower, fewer passes are enough.
+	benchmarkPrettyPrint<Point>("Point", passes / 20);
+	benchmarkPrettyPrint<ManyPoints>("ManyPoints", passes / 20);
+}
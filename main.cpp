@@ -1,148 +1,545 @@
-#include <string>
-#include <vector>
-#include <unordered_set>
-
-#include "reflection.hpp"
-
-// Use REFLECTABLE macro to indicate what data members u want to reflect.
-struct Point {
-	float x = 0;
-	float y = 0;
-
-	REFLECTABLE(x, y)
-};
-
-// The reflection library has access to private data members, regardless of where MACRO is placed.
-class Private {
-public: 
-	Private() = default;
-
-private:
-	int x[1] = { 0 };
-	std::size_t y = 0;
-
-	REFLECTABLE(x, y)
-};
-
-// You can selectively choose what data member to reflect
-struct Data {
-	std::string foo;
-	std::vector<int> bar;
-	std::unordered_set<float> baz;
-
-	REFLECTABLE(foo, baz)
-};
-
-// Reflection works recursively too, provided that the data members are also reflectable.
-struct Points {
-	Point pt1 {};
-	Point pt2 {};
-	Point pt3 {};
-
-	REFLECTABLE(pt1, pt2, pt3)
-};
-
-struct ManyPoints {
-	Points points1 { {6.0f, 5.0f}, {4.0f, 3.0f}, {2.0f, 1.0f} };
-	Point pt { 5.f, 5.f };
-	
-	int x = 10;
-	int y = 20;
-
-	Points points2{ {-16.0f, -15.0f}, {-14.0f, -13.0f}, {-12.0f, -11.0f} };
-
-	REFLECTABLE(points1, pt, x, y, points2)
-};
-
-int main() {
-	// =======================================================================
-	// 1.0 Simple printing.
-	Point point1;
-	reflection::print(point1);
-
-	std::cout << "\n";
-
-	// 1.1 Constness is respected.
-	Point const point2 {5, 10};
-	reflection::print(point2);
-
-	std::cout << "\n";
-
-	// 1.2 Reflection library has access to private data members
-	Private const foo;
-	reflection::print(foo);
-
-	std::cout << "\n";
-
-	// 1.3 You can check if class is reflectable.
-	if constexpr (reflection::isReflectable<Point>()) {
-		std::cout << "Class is reflectable.\n";
-	}
-	else {
-		std::cout << "Class is not reflectable.\n";
-	}
-
-	// =======================================================================
-	// 2.0 Using your own lambda to iterate through a reflected class
-	Data const data{ "Hello World!", {1, 2, 3}, {2.0f, 4.0f, 6.0f} };	// aggregate initialisation
-	
-	int counter = 0;
-
-	reflection::visit([&](auto fieldData) {	
-		auto& dataMember = fieldData.get();
-		const char* dataMemberName = fieldData.name();
-		
-		(void) dataMemberName; // unused
-
-		// From here you can do whatever you want with the data members.
-		// from printing, de/serialization, etc..
-
-		// Example printing...
-		std::cout << counter << ". ";
-
-		// assumes that data member implements .begin() and .end()
-		for (auto const& element : dataMember) {
-			std::cout << element << "-";
-		}
-
-		std::cout << "\n";
-		++counter;
-	}, data);
-
-	// 2.1 You can use if constexpr and type traits to do certain things based on type. Similar to std::visit.
-	reflection::visit([&](auto fieldData) {
-		using DataMemberType = std::decay_t<decltype(fieldData)>;
-		auto& dataMember = fieldData.get();
-
-		(void) dataMember; // unused
-
-		// Using if constexpr and type traits to do certain things based on type.
-		if constexpr (std::same_as<DataMemberType, std::string>) {
-			std::cout << "hey im a string!\n";
-		}
-	}, data);
-
-	// (Rare) 2.2 Niche cases where you need pointer to the data member
-	reflection::visit([](auto fieldData) {
-		auto pointerToDataMember = fieldData.getPointerToMember();
-		// do whatever u want with pointer to data member. ()
-
-		(void) pointerToDataMember; // unused
-	}, point2);
-
-	// =======================================================================
-	// 3.0 Recursive printing!
-	std::cout << "\nRecursive printing..\n";
-
-	Points const points{ {1.0f, 2.0f}, {3.0f, 4.0f}, {5.0f, 6.0f} };
-	reflection::print(points);
-
-	std::cout << "\n";
-
-	// 3.1 Regardless of depth.
-	ManyPoints manyPts;
-	reflection::prettyPrint(manyPts);
-
-	// 3.2 (Advanced) look at function definition of prettyPrint 
-	// to see how you could provide functors that will be invoked before and after iterating through a reflectable data member recursively.
-}
\ No newline at end of file
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <filesystem>
+#include <optional>
+#include <coroutine>
+#include <thread>
+#include <atomic>
+
+// MmapTable is opt-in, it needs POSIX mmap.
+#if !defined(REFLECTION_MMAP) && (defined(__unix__) || defined(__APPLE__))
+	#define REFLECTION_MMAP
+#endif
+
+#include "reflection.hpp"
+
+// Use REFLECTABLE macro to indicate what data members u want to reflect.
+struct Point {
+	float x = 0;
+	float y = 0;
+
+	REFLECTABLE(x, y)
+};
+
+// The reflection library has access to private data members, regardless of where MACRO is placed.
+class Private {
+public: 
+	Private() = default;
+
+private:
+	int x[1] = { 0 };
+	std::size_t y = 0;
+
+	REFLECTABLE(x, y)
+};
+
+// You can selectively choose what data member to reflect
+struct Data {
+	std::string foo;
+	std::vector<int> bar;
+	std::unordered_set<float> baz;
+
+	REFLECTABLE(foo, baz)
+};
+
+// Reflection works recursively too, provided that the data members are also reflectable.
+struct Points {
+	Point pt1 {};
+	Point pt2 {};
+	Point pt3 {};
+
+	REFLECTABLE(pt1, pt2, pt3)
+};
+
+// Data members with polymorphic allocators allocate from the resource given to deserialize.
+struct Message {
+	std::pmr::string text;
+	std::pmr::vector<std::pmr::string> tags;
+
+	REFLECTABLE(text, tags)
+};
+
+// Declaration order decides padding, layoutReport shows how much.
+struct Padded {
+	char tag = 'a';
+	double value = 0.0;
+	bool enabled = false;
+
+	REFLECTABLE(tag, value, enabled)
+};
+
+// Leaves become Arrow style columns with toColumns, std::optional leaves are nullable.
+struct Measurement {
+	std::string sensor;
+	float value = 0.f;
+	std::optional<float> error;
+
+	REFLECTABLE(sensor, value, error)
+};
+
+// ATTR chooses how data members are serialized, small integers as varints, a bounded float in 16 bits and a cache that is never written.
+struct Telemetry {
+	std::uint64_t sequence = 0;
+	std::int32_t offset = 0;
+	float temperature = 0.f;
+	double cachedAverage = 0.0;
+
+	REFLECTABLE(ATTR(sequence, varint), ATTR(offset, varint), ATTR(temperature, quantize(-40.0, 125.0)), ATTR(cachedAverage, skip))
+};
+
+// Shares x and y with Point, so reflection::assign converts between them by name.
+struct Vec3 {
+	float x = 0.f;
+	float y = 0.f;
+	float z = 1.f;
+
+	REFLECTABLE(x, y, z)
+};
+
+struct ManyPoints {
+	Points points1 { {6.0f, 5.0f}, {4.0f, 3.0f}, {2.0f, 1.0f} };
+	Point pt { 5.f, 5.f };
+	
+	int x = 10;
+	int y = 20;
+
+	Points points2{ {-16.0f, -15.0f}, {-14.0f, -13.0f}, {-12.0f, -11.0f} };
+
+	REFLECTABLE(points1, pt, x, y, points2)
+};
+
+int main() {
+	// =======================================================================
+	// 1.0 Simple printing.
+	Point point1;
+	reflection::print(point1);
+
+	std::cout << "\n";
+
+	// 1.1 Constness is respected.
+	Point const point2 {5, 10};
+	reflection::print(point2);
+
+	std::cout << "\n";
+
+	// 1.2 Reflection library has access to private data members
+	Private const foo;
+	reflection::print(foo);
+
+	std::cout << "\n";
+
+	// 1.3 Format into your own buffer instead of printing. Arithmetic and string data members never allocate.
+	char text[128];
+	auto const [end, size] = reflection::formatToN(text, sizeof(text), point2);
+	std::cout << std::string_view{ text, end } << " (" << size << " characters)\n";
+
+	std::cout << "\n";
+
+	// 1.4 You can check if class is reflectable.
+	if constexpr (reflection::isReflectable<Point>()) {
+		std::cout << "Class is reflectable.\n";
+	}
+	else {
+		std::cout << "Class is not reflectable.\n";
+	}
+
+	// =======================================================================
+	// 2.0 Using your own lambda to iterate through a reflected class
+	Data const data{ "Hello World!", {1, 2, 3}, {2.0f, 4.0f, 6.0f} };	// aggregate initialisation
+	
+	int counter = 0;
+
+	reflection::visit([&](auto fieldData) {	
+		auto& dataMember = fieldData.get();
+		const char* dataMemberName = fieldData.name();
+		
+		(void) dataMemberName; // unused
+
+		// From here you can do whatever you want with the data members.
+		// from printing, de/serialization, etc..
+
+		// Example printing...
+		std::cout << counter << ". ";
+
+		// assumes that data member implements .begin() and .end()
+		for (auto const& element : dataMember) {
+			std::cout << element << "-";
+		}
+
+		std::cout << "\n";
+		++counter;
+	}, data);
+
+	// 2.1 You can use if constexpr and type traits to do certain things based on type. Similar to std::visit.
+	reflection::visit([&](auto fieldData) {
+		using DataMemberType = std::decay_t<decltype(fieldData)>;
+		auto& dataMember = fieldData.get();
+
+		(void) dataMember; // unused
+
+		// Using if constexpr and type traits to do certain things based on type.
+		if constexpr (std::same_as<DataMemberType, std::string>) {
+			std::cout << "hey im a string!\n";
+		}
+	}, data);
+
+	// 2.2 Look up a data member by name, with a single hash and string comparison. Useful when reading keys from a file.
+	static_assert(reflection::indexOf<ManyPoints>("x") == 2);
+
+	reflection::visitField("y", [](auto fieldData) {
+		std::cout << "Found " << fieldData.name() << " = " << fieldData.get() << "\n";
+	}, point2);
+
+	// (Rare) 2.3 Niche cases where you need pointer to the data member
+	reflection::visit([](auto fieldData) {
+		auto pointerToDataMember = fieldData.getPointerToMember();
+		// do whatever u want with pointer to data member. ()
+
+		(void) pointerToDataMember; // unused
+	}, point2);
+
+	// 2.4 visit is constexpr, so tables of reflected data can be computed at compile time.
+	constexpr auto defaultCoordinates = [] {
+		std::array<float, 2> values {};
+		std::size_t i = 0;
+
+		reflection::visit([&](auto fieldData) { values[i++] = fieldData.get(); }, Point{ 1.f, 2.f });
+		return values;
+	}();
+
+	static_assert(defaultCoordinates[1] == 2.f);
+	static_assert(std::is_same_v<reflection::FieldTypes<Points>, reflection::TypeList<Point, Point, Point>>);
+
+	// 2.5 coVisit takes visitors returning awaitables, here every data member is handled on a thread of its own as if it waited for I/O.
+	// Up to 2 data members are in flight at once, and enterFunc and exitFunc still bracket the data members of nested objects.
+	struct ResumeOnThread {
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(std::coroutine_handle<> handle) const { std::thread([handle] { handle.resume(); }).detach(); }
+		void await_resume() const noexcept {}
+	};
+
+	Points const remotePoints { { 0.f, 1.f }, { 2.f, 3.f }, { 4.f, 5.f } };
+	std::atomic<int> fetchedFields = 0;
+	int nestedObjects = 0;
+
+	reflection::coVisit([&](auto fieldData) -> reflection::VisitTask {
+		co_await ResumeOnThread {};
+		fetchedFields += static_cast<int>(fieldData.get() != 0.f);
+	}, [&] { ++nestedObjects; }, [] {}, remotePoints, 2).wait();
+
+	std::cout << "\nFetched " << fetchedFields << " non zero data members of " << nestedObjects << " nested objects.\n";
+
+	// 2.6 Stateless descriptors, no object is needed until get is called. Non const objects give mutable references.
+	Point scaled { 1.0f, 2.0f };
+	reflection::forEachField<Point>([&](auto field) { field.get(scaled) *= 10.0f; });
+	std::cout << "Scaled point " << scaled.x << ", " << scaled.y << " (" << sizeof(reflection::Field<Point, 0>) << " byte descriptor)\n";
+
+	// 2.7 Visiting a subset of data members, chosen by name or by a type trait at compile time. The other data members generate no code.
+	float coordinateSum = 0.f;
+	reflection::visitIf<std::is_floating_point>([&](auto fieldData) { coordinateSum += fieldData.get(); }, remotePoints);
+
+	auto const [x, y] = reflection::project<Point, "y", "x">.tie(point2);
+	std::cout << "Sum of floating point leaves " << coordinateSum << ", point2 projected to (" << x << ", " << y << ")\n";
+
+	// =======================================================================
+	// 3.0 Recursive printing!
+	std::cout << "\nRecursive printing..\n";
+
+	Points const points{ {1.0f, 2.0f}, {3.0f, 4.0f}, {5.0f, 6.0f} };
+	reflection::print(points);
+
+	std::cout << "\n";
+
+	// 3.1 Regardless of depth.
+	ManyPoints manyPts;
+	reflection::prettyPrint(manyPts);
+
+	// 3.2 (Advanced) look at function definition of prettyPrint 
+	// to see how you could provide functors that will be invoked before and after iterating through a reflectable data member recursively.
+
+	// 3.3 Leaves are the non reflectable data members at the bottom of the tree. visitLeaves visits them in a single fold with dotted names.
+	reflection::visitLeaves([](auto leaf) {
+		std::cout << leaf.name() << " at offset " << leaf.offset() << " = " << leaf.get() << "\n";
+	}, points);
+
+	static_assert(reflection::flatFields<ManyPoints>()[3].name == "points1.pt2.y");
+
+	// =======================================================================
+	// 4.0 Binary serialization. Contiguous trivially copyable data members are copied with a single memcpy, even across nested reflectable data members.
+	std::vector<std::byte> buffer;
+	reflection::serialize(manyPts, buffer);
+
+	ManyPoints manyPtsCopy { {}, {}, 0, 0, {} };
+	std::size_t bytesRead = reflection::deserialize(buffer, manyPtsCopy);
+
+	std::cout << "\nSerialized ManyPoints into " << buffer.size() << " bytes, read back " << bytesRead << " bytes.\n";
+	reflection::prettyPrint(manyPtsCopy);
+
+	// 4.1 Read single data members straight from the serialized bytes. Nested reflectable data members give nested views,
+	// leaves are returned as std::optional, empty if the bytes end before them.
+	reflection::View<ManyPoints> manyPtsView { buffer };
+	std::cout << "points2.pt3.y read from the bytes = " << *manyPtsView.get<"points2">().get<"pt3">().get<"y">() << ", x = " << *manyPtsView.get<2>() << "\n";
+
+	reflection::View<ManyPoints> truncatedView { std::span{ buffer }.first(8) };
+	std::cout << "x read from the first 8 bytes only: " << (truncatedView.get<"x">() ? "present" : "missing") << "\n";
+
+	// 4.2 Strings and containers are written as an element count followed by every element.
+	buffer.clear();
+	reflection::serialize(data, buffer);
+
+	Data dataCopy;
+	reflection::deserialize(buffer, dataCopy);
+
+	std::cout << "Deserialized Data::foo = " << dataCopy.foo << ", Data::baz has " << dataCopy.baz.size() << " elements.\n";
+
+	// 4.3 Deserializing into an arena, every string and vector of the batch is released at once with the arena.
+	buffer.clear();
+	reflection::serialize(Message{ "Hello from the arena, too long for the small string buffer", { "first tag", "second tag" } }, buffer);
+
+	{
+		std::pmr::monotonic_buffer_resource arena;
+		std::pmr::vector<Message> messages { &arena };
+		messages.resize(4);
+
+		for (Message& message : messages) {
+			reflection::deserialize(buffer, message, &arena);
+		}
+
+		std::cout << "Deserialized " << messages.size() << " messages into an arena, last tag = " << messages.back().tags.back() << "\n";
+	}
+
+	// 4.4 Versioned format, the schema hash tells whether the layout changed, and leaves are matched by name when it did.
+	buffer.clear();
+	reflection::serializeVersioned(data, buffer);
+
+	Data versionedCopy;
+	reflection::deserializeVersioned(buffer, versionedCopy);
+	std::cout << "Schema hash of Data = " << std::hex << reflection::schemaHash<Data>() << std::dec << ", versioned copy of Data::foo = " << versionedCopy.foo << "\n";
+
+	// 4.5 JSON, nested reflectable data members become nested objects and containers become arrays.
+	std::string json;
+	reflection::json::write(points, json);
+	std::cout << "Points as JSON = " << json << "\n";
+
+	Points pointsFromJson;
+	if (reflection::json::read(R"({ "pt3": { "y": 7.5 }, "comment": "unknown keys are skipped" })", pointsFromJson)) {
+		std::cout << "Read pt3.y = " << pointsFromJson.pt3.y << " from JSON.\n";
+	}
+
+	// 4.6 Delta serialization only writes the data members that changed, recursing into reflectable data members.
+	ManyPoints const before;
+	ManyPoints after;
+	after.points1.pt2.x = 42.f;
+
+	buffer.clear();
+	reflection::serializeDelta(before, after, buffer);
+	std::cout << "Changed data members of ManyPoints = " << reflection::diff(before, after) << ", delta takes " << buffer.size() << " bytes.\n";
+
+	ManyPoints replica;
+	reflection::applyDelta(buffer, replica);
+	std::cout << "Replica points1.pt2.x = " << replica.points1.pt2.x << "\n";
+
+	// 4.7 Streaming in fixed size chunks, so memory is bounded by the chunk size. The sink could write to a socket, blocking while it is full.
+	Data bigData { "streamed", {}, {} };
+	for (int i = 0; i < 10000; ++i) {
+		bigData.baz.insert(static_cast<float>(i));
+	}
+
+	std::vector<std::byte> stream;
+	std::size_t chunkCount = 0;
+
+	{
+		reflection::StreamWriter writer { [&](std::span<const std::byte> chunk) {
+			stream.insert(stream.end(), chunk.begin(), chunk.end());
+			++chunkCount;
+			return true;
+		}, 4096 };
+
+		writer.write(bigData);
+		writer.flush();
+	}
+
+	std::size_t streamPosition = 0;
+	reflection::StreamReader reader { [&](std::span<std::byte> chunk) {
+		std::size_t const count = std::min(chunk.size(), stream.size() - streamPosition);
+		std::memcpy(chunk.data(), stream.data() + streamPosition, count);
+		streamPosition += count;
+		return count;
+	}, 4096 };
+
+	Data streamedData;
+	reader.read(streamedData);
+	std::cout << "Streamed " << stream.size() << " bytes in " << chunkCount << " chunks, Data::baz has " << streamedData.baz.size() << " elements.\n";
+
+	// 4.8 Attributes given with ATTR change the encoding of single data members, Telemetry takes 4 bytes instead of 24.
+	Telemetry const telemetry { 42, -3, 21.5f, 20.75 };
+	std::vector<std::byte> telemetryBytes;
+	reflection::serialize(telemetry, telemetryBytes);
+
+	Telemetry readTelemetry {};
+	reflection::deserialize(telemetryBytes, readTelemetry);
+	std::cout << "Telemetry in " << telemetryBytes.size() << " bytes, temperature " << readTelemetry.temperature << ", cachedAverage " << readTelemetry.cachedAverage << "\n";
+
+	// Deltas and JSON honour the attributes too, the skipped cachedAverage is neither compared, written nor read.
+	Telemetry replicaTelemetry {};
+	replicaTelemetry.cachedAverage = 5.0;
+	telemetryBytes.clear();
+	reflection::serializeDelta(Telemetry{}, telemetry, telemetryBytes);
+	reflection::applyDelta(telemetryBytes, replicaTelemetry);
+	reflection::json::read(R"({"cachedAverage":7})", replicaTelemetry);
+	std::cout << "Telemetry delta of " << reflection::diff(Telemetry{}, telemetry) << " in " << telemetryBytes.size() << " bytes, sequence " << replicaTelemetry.sequence << ", cachedAverage " << replicaTelemetry.cachedAverage << "\n";
+
+	// 4.9 Pooled objects are reset data member by data member when released, so Message::text keeps its capacity for the next message.
+	std::vector<std::byte> messageBytes;
+	reflection::serialize(Message{ "A message too long for the small string buffer of std::string", { "pooled" } }, messageBytes);
+
+	std::size_t textCapacity = 0;
+
+	for (int i = 0; i < 3; ++i) {
+		reflection::Pool<Message>::Handle pooled = reflection::pool<Message>().acquire();
+		textCapacity = pooled->text.capacity();
+		reflection::deserialize(messageBytes, *pooled);
+	}
+
+	std::cout << "Pooled Message acquired with a text capacity of " << textCapacity << "\n";
+
+	// =======================================================================
+	// 5.0 Struct of arrays container, every leaf data member is stored in its own column.
+	reflection::SoaVector<ManyPoints> soa;
+
+	for (int i = 0; i < 4; ++i) {
+		manyPts.x = i;
+		soa.push_back(manyPts);
+	}
+
+	soa[1].get<"points1.pt2.x">() = 100.f;	// nested data members are flattened and named by their path.
+
+	int sum = 0;
+	for (int x : soa.column<"x">()) {
+		sum += x;
+	}
+
+	ManyPoints const second = soa[1];
+	std::cout << "\nSum of x column = " << sum << ", points1.pt2.x of second element = " << second.points1.pt2.x << "\n";
+
+	// 5.1 Bulk operations over a column, using AVX2 or NEON for arithmetic columns when available.
+	reflection::transform<"pt.y">(soa, [](float y) { return y * 2.f; });
+
+	float const sumOfY = reflection::reduce<"pt.y">(soa, 0.f);
+	reflection::Bitmask const matches = reflection::compareEq<"x">(soa, 2);
+
+	std::cout << "Sum of pt.y column = " << sumOfY << ", " << matches.count() << " element(s) with x == 2\n";
+
+	// bool leaves are stored as real bools, so their columns can be viewed as a span as well.
+	reflection::SoaVector<Padded> padded;
+	padded.resize(3);
+	padded[2].get<"enabled">() = true;
+	std::cout << reflection::compareEq<"enabled">(padded, true).count() << " of " << padded.column<"enabled">().size() << " Padded element(s) enabled\n";
+
+	// 5.2 Arrow style column buffers of a batch of objects, in one pass over the objects. Strings get an offset buffer, and optional leaves a validity bitmap.
+	std::vector<Measurement> measurements { { "north", 1.5f, 0.1f }, { "south", 2.5f, std::nullopt }, { "east", 3.5f, 0.2f } };
+	reflection::ColumnBatch const batch = reflection::toColumns(std::span<Measurement const>{ measurements });
+
+	for (reflection::Column const& column : batch.columns) {
+		std::cout << column.name << " (" << column.format << "): " << column.values.size() << " bytes of values, " << column.nullCount << " null(s)\n";
+	}
+
+	std::vector<Measurement> measurementsCopy(batch.rows);
+	reflection::fromColumns(batch, std::span<Measurement>{ measurementsCopy });
+	std::cout << "Read back " << measurementsCopy.size() << " measurements, last sensor = " << measurementsCopy.back().sensor << "\n";
+
+	// =======================================================================
+	// 6.0 Layout of every reflected data member, computed at compile time without any object.
+	constexpr auto manyPointsLayout = reflection::layout<ManyPoints>();
+	static_assert(manyPointsLayout[2].offset == offsetof(ManyPoints, x));
+	static_assert(manyPointsLayout[0].typeId == reflection::typeId<Points>());
+
+	std::cout << "\nLayout of " << reflection::typeName<ManyPoints>() << "\n";
+
+	for (reflection::FieldLayout const& field : manyPointsLayout) {
+		std::cout << field.name << ": offset " << field.offset << ", size " << field.size << ", alignment " << field.alignment << "\n";
+	}
+
+	// 6.1 Padding report with a suggested order of data members, and a compile time check that there is no padding.
+	reflection::assertNoPadding<Points>();
+	std::cout << reflection::layoutReport<Padded>();
+
+	// =======================================================================
+	// 7.0 Visiting and serializing ranges of objects in parallel. The visitor must be safe to call concurrently.
+	std::vector<ManyPoints> const manyPointsRange(10000);
+	reflection::ThreadExecutor executor;
+
+	std::atomic<std::size_t> visitedFields = 0;
+	reflection::visitRange(executor, manyPointsRange, [&](auto) { ++visitedFields; });
+
+	buffer.clear();
+	reflection::serializeRange(executor, manyPointsRange, buffer);
+
+	std::cout << "\nVisited " << visitedFields << " data members, serialized " << manyPointsRange.size() << " objects into " << buffer.size() << " bytes.\n";
+
+	// =======================================================================
+	// 8.0 Hashing and equality generated from the reflected data members, for example to use reflectable classes as keys.
+	std::unordered_set<Point, reflection::Hash<Point>, reflection::EqualTo<Point>> const uniquePoints { { 1.f, 2.f }, { 1.f, 2.f }, { -0.f, 0.f }, { 0.f, 0.f } };
+	std::cout << "\n" << uniquePoints.size() << " unique points, Data equal to itself = " << std::boolalpha << reflection::equal(data, data) << std::noboolalpha << "\n";
+
+	// 8.1 Converting between classes sharing data member names. x and y are next to each other in both, so they are copied with one memcpy.
+	Vec3 vec { 0.f, 0.f, 2.f };
+	reflection::assign(vec, Point{ 3.f, 4.f });
+
+	std::vector<Vec3> vecs;
+	reflection::assignRange(vecs, std::vector<Point>(1000, Point{ 5.f, 6.f }));
+	std::cout << "Assigned Vec3 { " << vec.x << ", " << vec.y << ", " << vec.z << " } and " << vecs.size() << " more from points.\n";
+
+#if defined(REFLECTION_MMAP)
+	// =======================================================================
+	// 9.0 Memory mapped table of fixed size records, read in place without deserializing.
+	std::string const tablePath = (std::filesystem::temp_directory_path() / "many_points.table").string();
+	std::filesystem::remove(tablePath);
+
+	{
+		reflection::MmapTable<ManyPoints> table;
+
+		if (table.open(tablePath.c_str())) {
+			table.append(manyPointsRange);
+
+			float sumOfX = 0.f;
+
+			for (reflection::View<ManyPoints> record : table.records()) {
+				sumOfX += *record.get<"pt">().get<"x">();
+			}
+
+			std::cout << "\nMapped " << table.size() << " records, sum of pt.x = " << sumOfX << "\n";
+		}
+	}
+
+	std::filesystem::remove(tablePath);
+#endif
+
+	// =======================================================================
+	// 10.0 Runtime registry, working with reflectable classes through type erased descriptors looked up by type id.
+	reflection::registry::add<Points>();
+
+	if (reflection::registry::TypeDescriptor const* type = reflection::registry::find(reflection::typeId<Points>())) {
+		void const* object = &points;
+		std::cout << "\n" << type->name << " has " << type->fields.size() << " data members, " << reflection::registry::types().size() << " types registered.\n";
+
+		for (reflection::registry::FieldDescriptor const& field : type->fields) {
+			Point const* pt = field.as<Point>(object);
+			std::cout << field.name << " at offset " << field.offset << ", x = " << (pt ? pt->x : 0.f) << "\n";
+		}
+	}
+
+	// =======================================================================
+	// 11.0 Per type and per data member counters of everything above, when built with -DREFLECTION_INSTRUMENTATION.
+	if constexpr (reflection::instrumentation::enabled) {
+		std::cout << "\n";
+
+		for (reflection::instrumentation::Counter const& counter : reflection::instrumentation::snapshot()) {
+			if (counter.operation == reflection::instrumentation::Operation::serialize) {
+				std::cout << "serialize " << counter.type << (counter.field.empty() ? "" : ".") << counter.field << ": " << counter.calls << " calls, "
+					<< counter.cycles << " cycles, " << counter.bytes << " bytes\n";
+			}
+		}
+	}
+}
@@ -1,313 +1,6984 @@
-/*!*****************************************************************************************
-	This file contains macro definition REFLECTABLE that is responsible for static reflection by
-	generating metadata for every data member. It also contains template function declaration
-	that works with the reflected metadata.
-
-	Let's first look at example:
-
-	struct Person {
-		int x = 0;
-		float y = 5;
-
-		REFLECTABLE(x, y);
-	};
-
-	This will in turn create metadata (which is type FieldData) for each data member.
-	It should look something like this.. (many details are hidden for clarify)
-
-	struct Person {
-		int x = 0;
-		float y = 5;
-
-		struct FieldData<0> {
-			int& get()			{ return  x;  }
-			const char* name()	{ return "x"; }
-		}
-
-		struct FieldData<1> {
-			float& get()		{ return  y;  }
-			const char* name()	{ return "y"; }
-		}
-	};
-
-	With the generated metadata, we can iterate through all the data members of a given
-	reflectable class, and work with the individual data members via get().
-
-	Reference: https://stackoverflow.com/questions/41453/how-can-i-add-reflection-to-a-c-application
-	(goated link)
-
-*******************************************************************************************/
-
-#ifndef CPP_REFLECTION_H
-#define CPP_REFLECTION_H
-
-// i dont know why MSVC doesn't like conforming to the standard but ok.
-#if ((defined(_MSVC_LANG) && _MSVC_LANG < 202002L) || (!defined(_MSVC_LANG) && __cplusplus < 202002L))
-	#error "Requires at least C++20 support. Please ensure your compiler supports C++20."
-#elif defined(_MSC_VER) && (!defined(_MSVC_TRADITIONAL) || _MSVC_TRADITIONAL)
-	#error "For MSVC, please change project configuration to use standard conforming preprocessor! /Zc:preprocessor"
-	#error "Refer to README for simple guide in updating your project configuration."
-	#error "Go to project properties > C/C++ > Preprocessor > Use Standard Conforming Preprocessor and set it to Yes (/Zc:preprocessor)."
-#else
-
-#include <iostream>
-#include <string_view>
-#include <concepts>
-#include <type_traits>
-
-namespace reflection {
-	// For each data member, print it's name and value to stdout. Assumes the data member overloads the operator<<
-	template <typename T>
-	void print(T&& x);
-	
-	// Similar to print, but indents for each recursion depth.
-	template <typename T>
-	void prettyPrint(T&& x);
-
-	// Check if a given class is reflectable.
-	template <typename T>
-	constexpr bool isReflectable();
-
-	/*!***********************************************************************
-	* @brief
-	*	This function allows you to retrieve the metadata generated for each
-	*	reflected data member.
-	*
-	*	The function is designed such that template arguments are deduced automatically.
-	*
-	* @tparam Functor		: The type should ideally be a templated lambda with the following format: [](auto&&){}
-	*						  Capture clause doesn't matter here. Only the argument type.
-	* @tparam T				: The type of object you want to reflect.
-	*
-	* @param [in] x			: The object you want to reflect.
-	* @param [in] func		: Unary function object, which will be invoked for every reflected data member.
-	*						  fieldData.get() to retrieve reference to data member.
-	*						  fieldData.name() to retrieve name of data member.
-	*
-	**************************************************************************/
-	template<typename Functor, typename T>
-	void visit(Functor&& func, T&& x);
-
-	// similar to visit, but invokes enterFunc when first encountering a reflectable data member before recursing and invokes exitFunc after finishing iterating.
-	template<typename Functor, typename Functor2, typename Functor3, typename T>
-	void visit(Functor&& func, Functor2&& enterFunc, Functor3&& exitFunc, T&& x);
-}
-
-/*!========================================================================
-	Implementation details..
-========================================================================*/
-#define COUNT_ARGS(...) COUNT_ARGS_IMPL(__VA_ARGS__, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
-#define COUNT_ARGS_IMPL(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, N, ...) N
-
-// Applies macro for each variadic argument
-#define  APPLY_MACRO_TO_EACH_1(macro, index, a)																												macro(a, index)
-#define  APPLY_MACRO_TO_EACH_2(macro, index, a, b) 																											macro(a, index)  APPLY_MACRO_TO_EACH_1(macro, index + 1, b)
-#define  APPLY_MACRO_TO_EACH_3(macro, index, a, b, c) 																										macro(a, index)  APPLY_MACRO_TO_EACH_2(macro, index + 1, b, c)
-#define  APPLY_MACRO_TO_EACH_4(macro, index, a, b, c, d) 																									macro(a, index)  APPLY_MACRO_TO_EACH_3(macro, index + 1, b, c, d)
-#define  APPLY_MACRO_TO_EACH_5(macro, index, a, b, c, d, e) 																								macro(a, index)  APPLY_MACRO_TO_EACH_4(macro, index + 1, b, c, d, e)
-#define  APPLY_MACRO_TO_EACH_6(macro, index, a, b, c, d, e, f) 																								macro(a, index)  APPLY_MACRO_TO_EACH_5(macro, index + 1, b, c, d, e, f)
-#define  APPLY_MACRO_TO_EACH_7(macro, index, a, b, c, d, e, f, g) 																							macro(a, index)  APPLY_MACRO_TO_EACH_6(macro, index + 1, b, c, d, e, f, g)
-#define  APPLY_MACRO_TO_EACH_8(macro, index, a, b, c, d, e, f, g, h)																						macro(a, index)  APPLY_MACRO_TO_EACH_7(macro, index + 1, b, c, d, e, f, g, h)
-#define  APPLY_MACRO_TO_EACH_9(macro, index, a, b, c, d, e, f, g, h, i)																						macro(a, index)  APPLY_MACRO_TO_EACH_8(macro, index + 1, b, c, d, e, f, g, h, i)
-#define APPLY_MACRO_TO_EACH_10(macro, index, a, b, c, d, e, f, g, h, i, j)																					macro(a, index)  APPLY_MACRO_TO_EACH_9(macro, index + 1, b, c, d, e, f, g, h, i, j)
-#define APPLY_MACRO_TO_EACH_11(macro, index, a, b, c, d, e, f, g, h, i, j, k)																				macro(a, index) APPLY_MACRO_TO_EACH_10(macro, index + 1, b, c, d, e, f, g, h, i, j, k)
-#define APPLY_MACRO_TO_EACH_12(macro, index, a, b, c, d, e, f, g, h, i, j, k, l)																			macro(a, index) APPLY_MACRO_TO_EACH_11(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l)
-#define APPLY_MACRO_TO_EACH_13(macro, index, a, b, c, d, e, f, g, h, i, j, k, l, m)																			macro(a, index) APPLY_MACRO_TO_EACH_12(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l, m)
-#define APPLY_MACRO_TO_EACH_14(macro, index, a, b, c, d, e, f, g, h, i, j, k, l, m, n)																		macro(a, index) APPLY_MACRO_TO_EACH_13(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l, m, n)
-#define APPLY_MACRO_TO_EACH_15(macro, index, a, b, c, d, e, f, g, h, i, j, k, l, m, n, o)																	macro(a, index) APPLY_MACRO_TO_EACH_14(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l, m, n, o)
-#define APPLY_MACRO_TO_EACH_16(macro, index, a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p)																macro(a, index) APPLY_MACRO_TO_EACH_15(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p)
-#define APPLY_MACRO_TO_EACH_17(macro, index, a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q)																macro(a, index) APPLY_MACRO_TO_EACH_16(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q)
-#define APPLY_MACRO_TO_EACH_18(macro, index, a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r)															macro(a, index) APPLY_MACRO_TO_EACH_17(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r)
-#define APPLY_MACRO_TO_EACH_19(macro, index, a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s)														macro(a, index) APPLY_MACRO_TO_EACH_18(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s)
-#define APPLY_MACRO_TO_EACH_20(macro, index, a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t)													macro(a, index) APPLY_MACRO_TO_EACH_19(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t)
-#define APPLY_MACRO_TO_EACH_21(macro, index, a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u)													macro(a, index) APPLY_MACRO_TO_EACH_20(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u)
-#define APPLY_MACRO_TO_EACH_22(macro, index, a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v)												macro(a, index) APPLY_MACRO_TO_EACH_21(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v)
-#define APPLY_MACRO_TO_EACH_23(macro, index, a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w)											macro(a, index) APPLY_MACRO_TO_EACH_22(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w)
-#define APPLY_MACRO_TO_EACH_24(macro, index, a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x)										macro(a, index) APPLY_MACRO_TO_EACH_23(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x)
-#define APPLY_MACRO_TO_EACH_25(macro, index, a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x, y)										macro(a, index) APPLY_MACRO_TO_EACH_24(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x, y)
-#define APPLY_MACRO_TO_EACH_26(macro, index, a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x, y, z)									macro(a, index) APPLY_MACRO_TO_EACH_25(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x, y, z)
-#define APPLY_MACRO_TO_EACH_27(macro, index, a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x, y, z, aa)								macro(a, index) APPLY_MACRO_TO_EACH_26(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x, y, z, aa)
-#define APPLY_MACRO_TO_EACH_28(macro, index, a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x, y, z, aa, bb)							macro(a, index) APPLY_MACRO_TO_EACH_27(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x, y, z, aa, bb)
-#define APPLY_MACRO_TO_EACH_29(macro, index, a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x, y, z, aa, bb, cc)						macro(a, index) APPLY_MACRO_TO_EACH_28(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x, y, z, aa, bb, cc)
-#define APPLY_MACRO_TO_EACH_30(macro, index, a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x, y, z, aa, bb, cc, dd)					macro(a, index) APPLY_MACRO_TO_EACH_29(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x, y, z, aa, bb, cc, dd)
-#define APPLY_MACRO_TO_EACH_31(macro, index, a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x, y, z, aa, bb, cc, dd, ee)				macro(a, index) APPLY_MACRO_TO_EACH_30(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x, y, z, aa, bb, cc, dd, ee)
-#define APPLY_MACRO_TO_EACH_32(macro, index, a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x, y, z, aa, bb, cc, dd, ee, ff)			macro(a, index) APPLY_MACRO_TO_EACH_31(macro, index + 1, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p, q, r, s, t, u, v, w, x, y, z, aa, bb, cc, dd, ee, ff)
-
-// Dispatch to the correct APPLY_MACRO according to argument count.
-#define GET_MACRO(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, NAME, ...) NAME
-#define APPLY_MACRO_TO_EACH(macro, ...) GET_MACRO(__VA_ARGS__, APPLY_MACRO_TO_EACH_32, APPLY_MACRO_TO_EACH_31, APPLY_MACRO_TO_EACH_30, APPLY_MACRO_TO_EACH_29, APPLY_MACRO_TO_EACH_28, APPLY_MACRO_TO_EACH_27, APPLY_MACRO_TO_EACH_26, APPLY_MACRO_TO_EACH_25, APPLY_MACRO_TO_EACH_24, APPLY_MACRO_TO_EACH_23, APPLY_MACRO_TO_EACH_22, APPLY_MACRO_TO_EACH_21, APPLY_MACRO_TO_EACH_20, APPLY_MACRO_TO_EACH_19, APPLY_MACRO_TO_EACH_18, APPLY_MACRO_TO_EACH_17, APPLY_MACRO_TO_EACH_16, APPLY_MACRO_TO_EACH_15, APPLY_MACRO_TO_EACH_14, APPLY_MACRO_TO_EACH_13, APPLY_MACRO_TO_EACH_12, APPLY_MACRO_TO_EACH_11, APPLY_MACRO_TO_EACH_10, APPLY_MACRO_TO_EACH_9, APPLY_MACRO_TO_EACH_8, APPLY_MACRO_TO_EACH_7, APPLY_MACRO_TO_EACH_6, APPLY_MACRO_TO_EACH_5, APPLY_MACRO_TO_EACH_4, APPLY_MACRO_TO_EACH_3, APPLY_MACRO_TO_EACH_2, APPLY_MACRO_TO_EACH_1)(macro, 0, __VA_ARGS__)
-
-/*!***********************************************************************
-* @brief
-*	The macro responsible for static reflection. It generates metadata for every data member.
-*	Please take a look at the Reflection.hpp file level documentation if you want
-*	to understand the implementation details behind reflection.
-*
-* @param [in] ...					: Variadic argument list, containing all of the data members you want to reflect.
-*
-**************************************************************************/
-#define REFLECTABLE(...) \
-static int constexpr _reflection_fields_n = COUNT_ARGS(__VA_ARGS__); \
-friend reflection::query; \
-static_assert(_reflection_fields_n < 32, "Reflection does not support more than 32 data members."); \
-template<int N, typename Object> \
-struct FieldData {}; \
-APPLY_MACRO_TO_EACH(REFLECT_EACH, __VA_ARGS__) \
-
-#define REFLECT_EACH(dataMember, index) \
-\
-template<typename Object> \
-struct FieldData<index, Object> \
-{ \
-	using type = std::remove_cvref_t<decltype(std::decay_t<Object>::dataMember)>; \
-\
-    Object&& self; \
-\
-    constexpr FieldData(Object&& self) : self(self) {} \
-    \
-    constexpr decltype(std::remove_cvref_t<Object>::dataMember)& get() const requires(std::is_const_v<Object>) \
-    {\
-        return self.dataMember; \
-    }\
-    constexpr decltype(std::remove_cvref_t<Object>::dataMember) const& get() const requires(!std::is_const_v<Object>) \
-    {\
-        return self.dataMember; \
-    }\
-    constexpr char const* name() const \
-    {\
-        return #dataMember; \
-    }\
-	constexpr decltype(auto) getPointerToMember() { \
-		return &std::decay_t<Object>::dataMember;	\
-	}\
-}; \
-
-namespace reflection {
-	// class that has access to reflected private data members
-	struct query {
-		template <typename T>
-		constexpr static bool reflectable() {
-			return requires {
-				std::remove_cvref_t<T>::_reflection_fields_n;
-			};
-		}
-
-		template <typename T>
-		constexpr static auto getNumberOfFields() {
-			return std::remove_cvref_t<T>::_reflection_fields_n;
-		}
-
-		// Get a specific FieldData of object type T, index N.
-		template<int N, typename T>
-		static auto getFieldData(T&& object) {
-			return typename std::remove_cvref_t<T>::template FieldData<N, T>(std::forward<T>(object));
-		}
-	};
-
-	template <typename T>
-	constexpr bool isReflectable() {
-		return query::reflectable<T>();
-	}
-
-	template <typename T>
-	constexpr auto getNumberOfFields() {
-		return query::getNumberOfFields<T>();
-	}
-
-	template <typename T, typename Functor, std::size_t... ints>
-	void forEach(T&& x, Functor callback, std::integer_sequence<std::size_t, ints...>) {
-		(callback(query::getFieldData<ints>(std::forward<T>(x))), ...);	// Using the comma operator fold expression to invoke callback function for each field data.
-	}
-
-	template<typename T, typename Functor>
-	void iterateThroughMember(T&& x, Functor func) {
-		forEach(std::forward<T>(x), func, std::make_integer_sequence<std::size_t, query::getNumberOfFields<T>()>());
-	}
-
-	template<typename Functor, typename T>
-	void visit(Functor&& func, T&& x) {
-		visit(std::forward<Functor>(func), []{}, []{}, std::forward<T>(x));
-	}
-
-	template<typename Functor, typename Functor2, typename Functor3, typename T>
-	void visit(Functor&& func, Functor2&& enterFunc, Functor3&& exitFunc, T&& x) {
-		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
-
-		iterateThroughMember(std::forward<T>(x), [&]<typename U>(U&& fieldData) {
-			if constexpr (isReflectable<typename std::remove_cvref_t<U>::type>()) {
-				_internal_visit(std::forward<Functor>(func), std::forward<Functor2>(enterFunc), std::forward<Functor3>(exitFunc), std::forward<U>(fieldData).get());
-			}
-			else {
-				func(std::forward<U>(fieldData));
-			}
-		});
-	}
-
-	template<typename Functor, typename Functor2, typename Functor3, typename T>
-	void _internal_visit(Functor&& func, Functor2&& enterFunc, Functor3&& exitFunc, T&& x) {
-		enterFunc();
-
-		iterateThroughMember(std::forward<T>(x), [&]<typename U>(U && fieldData) {
-			if constexpr (isReflectable<typename std::remove_cvref_t<U>::type>()) {
-				_internal_visit(std::forward<Functor>(func), std::forward<Functor2>(enterFunc), std::forward<Functor3>(exitFunc), std::forward<U>(fieldData).get());
-			}
-			else {
-				func(std::forward<U>(fieldData));
-			}
-		});
-
-		exitFunc();
-	}
-
-	template <typename T>
-	void print(T&& x) {
-		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
-
-		visit([](auto fieldData) {
-				
-		}, std::forward<T>(x));
-	}
-
-	template <typename T>
-	void prettyPrint(T&& x) {
-		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
-
-		int recursionDepth = 0;
-
-		std::cout << "{\n";
-
-		visit(
-			[&recursionDepth](auto fieldData) {
-				for (int i = 0; i < recursionDepth + 1; ++i) {
-					std::cout << "    ";
-				}
-
-				std::cout << fieldData.name() << " = " << fieldData.get() << ",\n";
-			}, 
-			[&recursionDepth]() {
-				++recursionDepth;
-
-				for (int i = 0; i < recursionDepth; ++i) {
-					std::cout << "    ";
-				}
-				std::cout << "{\n";
-
-			},
-			[&recursionDepth]() {
-				for (int i = 0; i < recursionDepth; ++i) {
-					std::cout << "    ";
-				}
-				std::cout << "},\n";
-
-				--recursionDepth;
-			},
-			
-			std::forward<T>(x)
-		);
-
-		std::cout << "}\n";
-	}
-}
-
-#endif
+/*!*****************************************************************************************
+	This file contains macro definition REFLECTABLE that is responsible for static reflection by
+	generating metadata for every data member. It also contains template function declaration
+	that works with the reflected metadata.
+
+	Let's first look at example:
+
+	struct Person {
+		int x = 0;
+		float y = 5;
+
+		REFLECTABLE(x, y);
+	};
+
+	This will in turn create metadata (which is type FieldData) for each data member.
+	It should look something like this.. (many details are hidden for clarify)
+
+	struct Person {
+		int x = 0;
+		float y = 5;
+
+		struct FieldData<0> {
+			int& get()			{ return  x;  }
+			const char* name()	{ return "x"; }
+		}
+
+		struct FieldData<1> {
+			float& get()		{ return  y;  }
+			const char* name()	{ return "y"; }
+		}
+	};
+
+	With the generated metadata, we can iterate through all the data members of a given
+	reflectable class, and work with the individual data members via get().
+
+	Reference: https://stackoverflow.com/questions/41453/how-can-i-add-reflection-to-a-c-application
+	(goated link)
+
+*******************************************************************************************/
+
+#ifndef CPP_REFLECTION_H
+#define CPP_REFLECTION_H
+
+// i dont know why MSVC doesn't like conforming to the standard but ok.
+#if ((defined(_MSVC_LANG) && _MSVC_LANG < 202002L) || (!defined(_MSVC_LANG) && __cplusplus < 202002L))
+	#error "Requires at least C++20 support. Please ensure your compiler supports C++20."
+#elif defined(_MSC_VER) && (!defined(_MSVC_TRADITIONAL) || _MSVC_TRADITIONAL)
+	#error "For MSVC, please change project configuration to use standard conforming preprocessor! /Zc:preprocessor"
+	#error "Refer to README for simple guide in updating your project configuration."
+	#error "Go to project properties > C/C++ > Preprocessor > Use Standard Conforming Preprocessor and set it to Yes (/Zc:preprocessor)."
+#else
+
+#include <iostream>
+#include <string_view>
+#include <concepts>
+#include <type_traits>
+#include <array>
+#include <span>
+#include <ranges>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <functional>
+#include <bit>
+#include <charconv>
+#include <iterator>
+#include <streambuf>
+#include <bitset>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <new>
+#include <utility>
+#include <memory_resource>
+#include <optional>
+#include <limits>
+#include <coroutine>
+#include <condition_variable>
+
+// Counters of visit and the serializers are kept when REFLECTION_INSTRUMENTATION is defined, see reflection::instrumentation.
+#if defined(REFLECTION_INSTRUMENTATION)
+	#include <chrono>
+	#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		#include <intrin.h>
+	#elif defined(__x86_64__) || defined(__i386__)
+		#include <x86intrin.h>
+	#endif
+#endif
+
+// Bulk column operations and JSON scanning use AVX2 or NEON when the target supports them, JSON scanning falls back to SSE2 on x86-64.
+// Define REFLECTION_NO_SIMD to always use the scalar versions.
+#if !defined(REFLECTION_NO_SIMD) && defined(__AVX2__)
+	#define REFLECTION_AVX2
+	#include <immintrin.h>
+#elif !defined(REFLECTION_NO_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+	#define REFLECTION_NEON
+	#include <arm_neon.h>
+#elif !defined(REFLECTION_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+	#define REFLECTION_SSE2
+	#include <emmintrin.h>
+#endif
+
+// visitRange and serializeRange take std::execution policies when REFLECTION_EXECUTION_POLICIES is defined.
+// It is opt-in since libstdc++ implements parallel policies with TBB, which then has to be linked.
+#if defined(REFLECTION_EXECUTION_POLICIES)
+	#include <execution>
+#endif
+
+// MmapTable is available when REFLECTION_MMAP is defined. It is opt-in since it needs POSIX mmap, and the POSIX headers
+// declare names like read, write and close that everyone including this header would otherwise see too.
+#if defined(REFLECTION_MMAP)
+	#if !defined(__unix__) && !defined(__APPLE__)
+		#error "MmapTable needs POSIX mmap, undefine REFLECTION_MMAP on this platform."
+	#endif
+
+	#include <cerrno>
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace reflection {
+	// For each data member, print it's name and value to stdout on a single line. Formatted with formatTo.
+	template <typename T>
+	void print(T&& x);
+	
+	// Similar to print, but puts each data member on its own line and indents for each recursion depth.
+	template <typename T>
+	void prettyPrint(T&& x);
+
+	struct FormatOptions {
+		bool pretty = false;		// one data member per line, indented for each recursion depth.
+		int indentWidth = 4;
+	};
+
+	/*!***********************************************************************
+	* @brief
+	*	Writes the name and value of every data member of x to out, as text.
+	*
+	*	Arithmetic data members are formatted with std::to_chars and strings are
+	*	copied as is, neither allocates. Ranges are written as [a, b, c].
+	*	Any other data member is written with its operator<<, through a stream
+	*	that writes straight to out.
+	*
+	* @param [in] out		: Output iterator of char, like a char* into a caller supplied buffer or std::back_inserter.
+	* @param [in] x			: The object you want to format.
+	* @param [in] options	: Formatting options.
+	*
+	* @return				: Iterator past the last character written.
+	**************************************************************************/
+	template <typename OutputIt, typename T>
+	OutputIt formatTo(OutputIt out, T const& x, FormatOptions options = {});
+
+	template <typename OutputIt>
+	struct FormatToNResult {
+		OutputIt out;
+		std::size_t size;	// characters the whole output needs, which can be more than were written.
+	};
+
+	// Like formatTo, but writes at most n characters.
+	template <typename OutputIt, typename T>
+	FormatToNResult<OutputIt> formatToN(OutputIt out, std::size_t n, T const& x, FormatOptions options = {});
+
+	// Check if a given class is reflectable.
+	template <typename T>
+	constexpr bool isReflectable();
+
+	// Number of data members provided to REFLECTABLE.
+	template <typename T>
+	constexpr auto getNumberOfFields();
+
+	/*!***********************************************************************
+	* @brief
+	*	This function allows you to retrieve the metadata generated for each
+	*	reflected data member.
+	*
+	*	The function is designed such that template arguments are deduced automatically.
+	*
+	* @tparam Functor		: The type should ideally be a templated lambda with the following format: [](auto&&){}
+	*						  Capture clause doesn't matter here. Only the argument type.
+	* @tparam T				: The type of object you want to reflect.
+	*
+	* @param [in] x			: The object you want to reflect.
+	* @param [in] func		: Unary function object, which will be invoked for every reflected data member.
+	*						  fieldData.get() to retrieve reference to data member.
+	*						  fieldData.name() to retrieve name of data member.
+	*
+	**************************************************************************/
+	template<typename Functor, typename T>
+	constexpr void visit(Functor&& func, T&& x);
+
+	// similar to visit, but invokes enterFunc when first encountering a reflectable data member before recursing and invokes exitFunc after finishing iterating.
+	template<typename Functor, typename Functor2, typename Functor3, typename T>
+	constexpr void visit(Functor&& func, Functor2&& enterFunc, Functor3&& exitFunc, T&& x);
+
+	// Descriptor of data member N of T without any state. get(x) returns the data member of x, keeping the constness and value category of x.
+	template <typename T, std::size_t N>
+	struct Field;
+
+	/*!***********************************************************************
+	* @brief
+	*	Invokes func with a Field for every reflected data member of T. The
+	*	descriptors are empty and need no object, so visiting through them
+	*	folds to plain data member accesses.
+	*
+	*	reflection::forEachField<Point>([&](auto field) { field.get(point) *= 2.f; });
+	*
+	**************************************************************************/
+	template <typename T, typename Functor>
+	constexpr void forEachField(Functor&& func);
+
+	// Coroutine returned by coVisit. It starts when awaited, or when wait() is called from code that isn't a coroutine.
+	class VisitTask;
+
+	/*!***********************************************************************
+	* @brief
+	*	Like the 4 argument visit, but func may return an awaitable, for
+	*	visitors doing I/O per data member. Up to fanOut data members are in
+	*	flight at once: while one awaitable is suspended the next data member
+	*	is started. Visitors returning void are called synchronously.
+	*
+	*	enterFunc and exitFunc keep their nesting, every data member inside a
+	*	nested reflectable data member completes after its enterFunc and before
+	*	its exitFunc, data members of the same object overlap.
+	*
+	*	The first exception thrown by a visitor is rethrown once every data
+	*	member in flight completed. x must outlive the task, which resumes on
+	*	whichever thread completed the last awaitable.
+	**************************************************************************/
+	template<typename Functor, typename Functor2, typename Functor3, typename T>
+	VisitTask coVisit(Functor func, Functor2 enterFunc, Functor3 exitFunc, T& x, std::size_t fanOut = 1);
+
+	template<typename Functor, typename T>
+	VisitTask coVisit(Functor func, T& x, std::size_t fanOut = 1);
+
+	// Name of type T as spelled by the compiler, available at compile time. The spelling differs between compilers.
+	template <typename T>
+	constexpr std::string_view typeName();
+
+	// 64 bit FNV-1a hash of typeName<T>(), usable as a compile time type identifier.
+	template <typename T>
+	constexpr std::uint64_t typeId();
+
+	// Layout of a single reflected data member.
+	struct FieldLayout {
+		std::string_view name;
+		std::size_t offset;
+		std::size_t size;
+		std::size_t alignment;
+		std::uint64_t typeId;
+	};
+
+	/*!***********************************************************************
+	* @brief
+	*	Returns the layout of every reflected data member of T, in the order
+	*	given to REFLECTABLE. Computed entirely at compile time, no object needed.
+	*
+	*	constexpr auto fields = reflection::layout<Point>();
+	*	static_assert(fields[1].offset == offsetof(Point, y));
+	*
+	* @tparam T				: Reflectable class.
+	*
+	**************************************************************************/
+	template <typename T>
+	constexpr std::array<FieldLayout, getNumberOfFields<T>()> layout();
+
+	// Number of leaves of T, the non reflectable data members reached by recursing through reflectable data members.
+	template <typename T>
+	constexpr std::size_t getNumberOfLeaves();
+
+	/*!***********************************************************************
+	* @brief
+	*	Layout of every leaf of T in visit order, with dotted names like
+	*	"points1.pt2.x" and offsets from the start of T.
+	*
+	*	static_assert(reflection::flatFields<Points>()[1].name == "pt1.y");
+	*
+	**************************************************************************/
+	template <typename T>
+	constexpr std::array<FieldLayout, getNumberOfLeaves<T>()> flatFields();
+
+	// Leaf I of Object handed to visitLeaves visitors. get() returns a reference to the leaf, name() its dotted name.
+	template <std::size_t I, typename Object>
+	struct LeafField;
+
+	/*!***********************************************************************
+	* @brief
+	*	Like visit without enter and exit functions, but invokes func with a
+	*	LeafField for every leaf of x in a single fold expression instead of
+	*	recursing level by level, which keeps deep trees cheap to instantiate
+	*	and easy to inline.
+	**************************************************************************/
+	template <typename Functor, typename T>
+	constexpr void visitLeaves(Functor&& func, T&& x);
+
+	// Cache line size layoutReport checks data members against.
+	inline constexpr std::size_t cacheLineSize = 64;
+
+	// Reflected data member in a LayoutReport.
+	struct FieldReport {
+		FieldLayout layout;
+		std::size_t paddingBefore;		// bytes between the end of the previous data member and this one.
+		bool straddlesCacheLine;		// spans two cache lines, assuming the object starts on one.
+	};
+
+	template <std::size_t N>
+	struct LayoutReport {
+		std::string_view name;
+		std::size_t size;
+		std::size_t alignment;
+		std::size_t padding;			// bytes not covered by any reflected data member, tail padding included.
+		std::size_t tailPadding;
+		std::size_t straddling;			// number of data members straddling a cache line.
+		std::array<FieldReport, N> fields;	// sorted by offset.
+		std::array<std::string_view, N> suggestedOrder;	// data members sorted by decreasing alignment.
+		std::size_t suggestedSize;		// sizeof(T) if the data members were declared in suggestedOrder.
+	};
+
+	/*!***********************************************************************
+	* @brief
+	*	Reports how much padding T wastes and where, which data members straddle
+	*	cache lines and an order of data members with the least padding.
+	*	Computed at compile time, and printable with operator<<.
+	*
+	*	constexpr auto report = reflection::layoutReport<Data>();
+	*	static_assert(report.padding <= 4);
+	*	std::cout << report;
+	*
+	*	Data members left out of REFLECTABLE are counted as padding.
+	*
+	**************************************************************************/
+	template <typename T>
+	constexpr LayoutReport<getNumberOfFields<T>()> layoutReport();
+
+	template <std::size_t N>
+	std::ostream& operator<<(std::ostream& stream, LayoutReport<N> const& report);
+
+	// Fails to compile if T has padding between or after its reflected data members.
+	template <typename T>
+	constexpr void assertNoPadding();
+
+	/*!***********************************************************************
+	* @brief
+	*	Index of the reflected data member called name, or getNumberOfFields<T>()
+	*	if there is none. Looks the name up in a perfect hash table generated at
+	*	compile time from the REFLECTABLE names, costing one hash and one string
+	*	comparison regardless of the number of data members.
+	*
+	*	static_assert(reflection::indexOf<Point>("y") == 1);
+	*
+	**************************************************************************/
+	template <typename T>
+	constexpr std::size_t indexOf(std::string_view name);
+
+	// Runtime counterpart of indexOf, for names only known at runtime like keys read from a file.
+	template <typename T>
+	std::size_t findField(std::string_view name);
+
+	// Invokes func with the FieldData of the data member called name. Returns false if x has no such data member.
+	template<typename Functor, typename T>
+	bool visitField(std::string_view name, Functor&& func, T&& x);
+
+	// Any resizable contiguous container of bytes, like std::vector<std::byte>, std::vector<char> or std::string.
+	template <typename Buffer>
+	concept ByteBuffer = requires(Buffer& buffer, std::size_t size) {
+		buffer.resize(size);
+		{ buffer.size() } -> std::convertible_to<std::size_t>;
+		{ buffer.data() } -> std::convertible_to<void const*>;
+	} && sizeof(typename Buffer::value_type) == 1;
+
+	/*!***********************************************************************
+	* @brief
+	*	Appends the binary representation of a reflectable object to buffer.
+	*
+	*	Data members are written in visit order, reflectable data members are
+	*	flattened recursively. Neighbouring trivially copyable data members that
+	*	are contiguous in memory are written with a single memcpy. Containers are
+	*	written as a 64 bit element count followed by every element.
+	*	The format uses native endianness and contains no padding.
+	*
+	* @param [in] x			: The object you want to serialize.
+	* @param [out] buffer	: Buffer the bytes are appended to.
+	*
+	**************************************************************************/
+	template <typename T, ByteBuffer Buffer>
+	void serialize(T const& x, Buffer& buffer);
+
+	// Reads back an object written by serialize. Returns the number of bytes consumed, or 0 if bytes is truncated or malformed.
+	template <typename T>
+	std::size_t deserialize(std::span<const std::byte> bytes, T& x);
+
+	/*!***********************************************************************
+	* @brief
+	*	Like deserialize, but data members using polymorphic allocators, such
+	*	as std::pmr::string or std::pmr::vector, allocate from resource,
+	*	elements and nested reflectable data members included. With a
+	*	std::pmr::monotonic_buffer_resource a whole batch of objects is
+	*	released at once.
+	**************************************************************************/
+	template <typename T>
+	std::size_t deserialize(std::span<const std::byte> bytes, T& x, std::pmr::memory_resource* resource);
+
+	/*!***********************************************************************
+	* @brief
+	*	Fingerprint of the names, types and order of the reflected data members
+	*	of T, recursing through reflectable data members and the elements of
+	*	containers. Types are identified by typeId, so fingerprints should only
+	*	be compared between builds of the same compiler.
+	**************************************************************************/
+	template <typename T>
+	constexpr std::uint64_t schemaHash();
+
+	/*!***********************************************************************
+	* @brief
+	*	Like serialize, but prefixed with schemaHash<T>() and a table giving
+	*	the dotted name, type and size of every leaf, so the bytes can be read
+	*	back after T changed.
+	**************************************************************************/
+	template <typename T, ByteBuffer Buffer>
+	void serializeVersioned(T const& x, Buffer& buffer);
+
+	/*!***********************************************************************
+	* @brief
+	*	Reads back an object written by serializeVersioned. If the schema hash
+	*	matches, the table is skipped and the rest is read exactly like
+	*	deserialize. Otherwise every leaf of x is looked up by name in the table
+	*	and read if its type is unchanged, leaves that were added, removed or
+	*	changed type keep their current value.
+	*
+	* @return				: Number of bytes consumed, or 0 if bytes is truncated or malformed.
+	**************************************************************************/
+	template <typename T>
+	std::size_t deserializeVersioned(std::span<const std::byte> bytes, T& x);
+
+	// Destination of a StreamWriter, called with every chunk. Blocking until the chunk is accepted applies backpressure, returning false stops the stream.
+	template <typename S>
+	concept ByteSink = requires(S& sink, std::span<const std::byte> chunk) {
+		{ sink(chunk) } -> std::convertible_to<bool>;
+	};
+
+	// Source of a StreamReader, fills as much of buffer as it can and returns the number of bytes written, 0 at the end of the stream.
+	template <typename S>
+	concept ByteSource = requires(S& source, std::span<std::byte> buffer) {
+		{ source(buffer) } -> std::convertible_to<std::size_t>;
+	};
+
+	/*!***********************************************************************
+	* @brief
+	*	Writes objects in the serialize format to a sink in chunks of a fixed
+	*	size, so memory use is bounded by the chunk size rather than by the
+	*	size of the objects. Containers are copied into the chunk piece by
+	*	piece, a fixed size object larger than a chunk gets a chunk of its own.
+	*
+	*	reflection::StreamWriter writer { [&](std::span<const std::byte> chunk) {
+	*		return ::write(fd, chunk.data(), chunk.size()) == chunk.size();
+	*	} };
+	*	writer.write(data);
+	*	writer.flush();
+	*
+	**************************************************************************/
+	template <ByteSink Sink>
+	class StreamWriter;
+
+	/*!***********************************************************************
+	* @brief
+	*	Reads objects written by StreamWriter, or serialize, from a source in
+	*	chunks. Decoding pulls more bytes from the source whenever the chunk
+	*	runs out, mid container included, and large contiguous containers are
+	*	read straight into their elements. Bytes read past the end of an object
+	*	are kept for the next read.
+	*
+	*	Containers allocate at most a chunk ahead of the bytes they received,
+	*	so an untrusted element count can't make read allocate more than the
+	*	source delivers. Running out of memory makes read return false.
+	**************************************************************************/
+	template <ByteSource Source>
+	class StreamReader;
+
+	/*!***********************************************************************
+	* @brief
+	*	Serialization hints of a data member, given in REFLECTABLE with ATTR,
+	*	REFLECTABLE(x, ATTR(y, varint)). FieldData::attributes() returns them
+	*	at compile time. serialize, deserialize, the stream classes and
+	*	serializeVersioned encode leaves with them, and json::write leaves out
+	*	skipped data members. Attributes of a reflectable data member apply to
+	*	its leaves that have none of their own.
+	**************************************************************************/
+	struct FieldAttributes {
+		bool skip = false;				// transient, not written and left untouched when reading.
+		bool varint = false;			// integers written in LEB128, signed ones zigzag encoded first.
+		std::size_t fixedWidth = 0;		// integers written in this many bytes, truncating larger values.
+		bool quantized = false;			// floating point values written as 16 bits spread over [minimum, maximum].
+		double minimum = 0.0;
+		double maximum = 0.0;
+
+		constexpr FieldAttributes() = default;
+
+		template <typename... Attributes>
+		constexpr explicit FieldAttributes(Attributes... attributes) {
+			(attributes.apply(*this), ...);
+		}
+
+		// Whether the data member needs an encoding other than the one of its type.
+		constexpr bool encoded() const {
+			return skip || varint || fixedWidth != 0 || quantized;
+		}
+	};
+
+	// Attributes accepted by ATTR, usable there without the namespace.
+	namespace attributes {
+		inline constexpr struct Skip {
+			constexpr void apply(FieldAttributes& attributes) const { attributes.skip = true; }
+		} skip {};
+
+		inline constexpr struct Varint {
+			constexpr void apply(FieldAttributes& attributes) const { attributes.varint = true; }
+		} varint {};
+
+		template <std::size_t Bytes>
+		struct FixedWidth {
+			static_assert(Bytes == 1 || Bytes == 2 || Bytes == 4 || Bytes == 8, "Fixed width must be 1, 2, 4 or 8 bytes.");
+
+			constexpr void apply(FieldAttributes& attributes) const { attributes.fixedWidth = Bytes; }
+		};
+
+		template <std::size_t Bytes>
+		inline constexpr FixedWidth<Bytes> fixedWidth {};
+
+		struct Quantize {
+			double minimum;
+			double maximum;
+
+			constexpr void apply(FieldAttributes& attributes) const {
+				attributes.quantized = true;
+				attributes.minimum = minimum;
+				attributes.maximum = maximum;
+			}
+		};
+
+		// Values outside [minimum, maximum] are clamped, the step is (maximum - minimum) / 65535.
+		constexpr Quantize quantize(double minimum, double maximum) {
+			return { minimum, maximum };
+		}
+	}
+
+	// String literal usable as a template argument, reflection::View<Point>{ bytes }.get<"x">()
+	template <std::size_t N>
+	struct FixedString {
+		char characters[N] {};
+
+		constexpr FixedString(char const (&string)[N]) {
+			std::copy_n(string, N, characters);
+		}
+
+		constexpr std::string_view view() const {
+			return { characters, N - 1 };
+		}
+	};
+
+	/*!***********************************************************************
+	* @brief
+	*	Subset of the data members of T chosen by name at compile time, used
+	*	through the project variable. Only the chosen data members generate
+	*	code, and they are visited in the order they are named.
+	*
+	*	reflection::project<Data, "foo", "baz">.visit(func, data);
+	*	auto [x, y] = reflection::project<Point, "x", "y">.tie(point);
+	*	std::size_t key = reflection::project<Data, "foo">.hash(data);
+	*
+	**************************************************************************/
+	template <typename T, FixedString... Names>
+	struct Projection;
+
+	/*!***********************************************************************
+	* @brief
+	*	Like visit, but only invokes func for leaves whose type satisfies the
+	*	type trait Predicate, reflection::visitIf<std::is_arithmetic>(func, x).
+	*	Fields are selected at compile time, data members and reflectable data
+	*	members without a selected leaf don't generate any code.
+	**************************************************************************/
+	template <template <typename> typename Predicate, typename Functor, typename T>
+	constexpr void visitIf(Functor&& func, T&& x);
+
+	/*!***********************************************************************
+	* @brief
+	*	Read only view over an object written by serialize, reading individual
+	*	data members without deserializing the whole object.
+	*
+	*	Positions of data members are computed at compile time as long as every
+	*	data member before them has a fixed size. Data members after a string or
+	*	container are found by skipping over the variable sized data.
+	*
+	*	get<"name">() or get<N>() returns
+	*	- a View of the data member if it is reflectable,
+	*	- a std::optional<std::string_view> into the bytes for std::string,
+	*	- a std::optional copy of the data member otherwise.
+	*
+	*	Every read is bounds checked, the optional is empty if the bytes end
+	*	before the data member does. The bytes must outlive the view.
+	*
+	* @tparam T				: Reflectable class that was serialized.
+	*
+	**************************************************************************/
+	template <typename T>
+	class View;
+
+	/*!***********************************************************************
+	* @brief
+	*	Struct of arrays container. Every leaf of T (reflectable data members are
+	*	flattened recursively) is stored in its own contiguous column, so loops
+	*	over a single data member only touch that data member's memory.
+	*
+	*	Columns are named by the path of data member names leading to them,
+	*	column<"x">() for Point, column<"points1.pt2.x">() for ManyPoints.
+	*	operator[] returns a proxy, get<"x">() on it gives a reference into the column.
+	*
+	* @tparam T				: Reflectable, default constructible class.
+	*
+	**************************************************************************/
+	template <typename T>
+	class SoaVector;
+
+#if defined(REFLECTION_MMAP)
+	/*!***********************************************************************
+	* @brief
+	*	Append only file of fixed size records, memory mapped so they can be
+	*	read in place with View<T> instead of being deserialized. Records use
+	*	the serialize format, behind a header holding schemaHash<T>().
+	*	Every leaf of T must be trivially copyable.
+	*
+	*	reflection::MmapTable<Point> table;
+	*	table.open("points.table");
+	*	table.append(Point{ 1.f, 2.f });
+	*	float x = *table[0].get<"x">();
+	*
+	**************************************************************************/
+	template <typename T>
+	class MmapTable;
+#endif
+
+	namespace json {
+		/*!***********************************************************************
+		* @brief
+		*	Appends x to buffer as a JSON object. Reflectable data members become
+		*	nested objects, ranges become arrays, and ranges of pairs with string
+		*	keys (std::map<std::string, V>) become objects.
+		*	Non finite floating point values are written as null.
+		*
+		**************************************************************************/
+		template <typename T, ByteBuffer Buffer>
+		void write(T const& x, Buffer& buffer);
+
+		/*!***********************************************************************
+		* @brief
+		*	Parses a JSON object straight into the data members of x, without
+		*	building an intermediate document. Keys are matched with findField,
+		*	unknown keys are skipped and null leaves a data member untouched.
+		*
+		* @return				: false if json is malformed or doesn't match the types of the data members.
+		**************************************************************************/
+		template <typename T>
+		bool read(std::string_view json, T& x);
+	}
+
+	// Bit i is set if data member i of before and after differ. Reflectable data members are compared data member by data member, skipped ones never differ.
+	template <typename T>
+	std::bitset<getNumberOfFields<T>()> diff(T const& before, T const& after);
+
+	/*!***********************************************************************
+	* @brief
+	*	Appends only the data members that differ between before and after.
+	*	Every object is written as a bit per data member followed by the changed
+	*	data members, changed reflectable data members are written as deltas
+	*	themselves, so a single changed float deep inside an object costs a few
+	*	bytes. Other data members use the serialize format, ATTR encodings
+	*	included, and skipped data members are never written.
+	*
+	* @param [in] before	: State the receiver already has.
+	* @param [in] after		: State the receiver should end up with.
+	* @param [out] buffer	: Buffer the bytes are appended to.
+	*
+	**************************************************************************/
+	template <typename T, ByteBuffer Buffer>
+	void serializeDelta(T const& before, T const& after, Buffer& buffer);
+
+	// Applies a delta written by serializeDelta to x. Returns the number of bytes consumed, or 0 if bytes is truncated or malformed.
+	template <typename T>
+	std::size_t applyDelta(std::span<const std::byte> bytes, T& x);
+
+	/*!***********************************************************************
+	* @brief
+	*	Compares every reflected data member of a and b. Neighbouring integer,
+	*	enum and pointer data members without padding in between are compared
+	*	with a single memcmp, other data members with operator== (containers
+	*	element by element, reflectable elements with equal).
+	**************************************************************************/
+	template <typename T>
+	bool equal(T const& a, T const& b);
+
+	// Hash of every reflected data member of x, consistent with equal. Byte runs that equal would memcmp are hashed 8 bytes at a time.
+	template <typename T>
+	std::size_t hash(T const& x);
+
+	// Function objects for unordered containers, or to specialize std::hash with: template <> struct std::hash<Point> : reflection::Hash<Point> {};
+	template <typename T>
+	struct Hash {
+		std::size_t operator()(T const& x) const { return hash(x); }
+	};
+
+	template <typename T>
+	struct EqualTo {
+		bool operator()(T const& a, T const& b) const { return equal(a, b); }
+	};
+
+	/*!***********************************************************************
+	* @brief
+	*	Assigns every reflected data member of destination from the data
+	*	member of source with the same name, matched at compile time. Data
+	*	members without a namesake keep their value. Differing types are
+	*	converted, reflectable ones recursively by name and containers
+	*	element by element. When the matched data members have the same
+	*	trivially copyable types and sit next to each other in both classes,
+	*	they are copied with a single memcpy.
+	**************************************************************************/
+	template <typename Destination, typename Source>
+	void assign(Destination& destination, Source const& source);
+
+	/*!***********************************************************************
+	* @brief
+	*	assign for every element of source into the element of destination at
+	*	the same position. Destinations with resize, like std::vector, are
+	*	resized to source first. Contiguous ranges of classes whose reflected
+	*	data members cover both layouts identically are copied with a single
+	*	memcpy.
+	*
+	* @return				: Number of elements assigned.
+	**************************************************************************/
+	template <std::ranges::random_access_range Destination, std::ranges::random_access_range Source>
+	std::size_t assignRange(Destination&& destination, Source const& source);
+
+	/*!***********************************************************************
+	* @brief
+	*	Gives every reflected data member of x the value it has in a default
+	*	constructed T. Containers that are empty by default are cleared rather
+	*	than replaced, so vectors and strings keep their capacity, and runs of
+	*	trivially copyable data members are copied from a default T with memcpy.
+	*	Data members that can only be moved, like std::unique_ptr, are moved
+	*	from a T default constructed for that call.
+	**************************************************************************/
+	template <typename T>
+	void reset(T& x);
+
+	/*!***********************************************************************
+	* @brief
+	*	Recycles objects of T instead of destroying them. Released objects are
+	*	reset and kept in a free list of the releasing thread, so objects
+	*	acquired and released by the same thread never touch shared state.
+	*	Free lists that grow too long hand half of their objects to a lock free
+	*	list shared by all threads, which threads with empty free lists take
+	*	from before constructing new objects. deserialize reuses the capacity
+	*	of strings and of containers of trivially copyable elements, so messages
+	*	made of those need no heap allocations once the pool is warm. Elements
+	*	that own memory themselves, like the strings of a std::vector<std::string>,
+	*	and the nodes of sets and maps are freed by reset and allocated again.
+	*	Handles release from a noexcept destructor, so an object whose reset
+	*	throws, for instance copying a default string, is destroyed instead.
+	*	There is one pool per type, returned by pool<T>().
+	*
+	*	reflection::Pool<Message>::Handle message = reflection::pool<Message>().acquire();
+	*	reflection::deserialize(bytes, *message);	// released when message goes out of scope.
+	*
+	**************************************************************************/
+	template <typename T>
+	class Pool;
+
+	template <typename T>
+	Pool<T>& pool();
+
+	// Runs task(i) for every i in [0, count), possibly concurrently, and returns once all of them finished.
+	template <typename E>
+	concept Executor = requires(E& executor, void (*task)(std::size_t)) {
+		executor.run(std::size_t{}, task);
+	};
+
+	// Executor keeping threads - 1 worker threads alive for its lifetime, the thread calling run works as well.
+	// Every thread picks the next task as it finishes one. Calls to run on the same executor take turns, so tasks must not call run on it.
+	class ThreadExecutor;
+
+	/*!***********************************************************************
+	* @brief
+	*	Calls visit(func, element) for every element of range. The range is
+	*	split into chunks of neighbouring elements that run as one task each,
+	*	so func must be safe to call concurrently.
+	*
+	* @param [in] executor	: Executor running the chunks, or a std::execution policy if REFLECTION_EXECUTION_POLICIES is defined.
+	* @param [in] range		: Random access range of reflectable objects.
+	* @param [in] func		: Visitor, the same as the one given to visit.
+	* @param [in] chunkSize	: Elements per task, 0 picks about 16KiB worth of elements.
+	*
+	**************************************************************************/
+	template <typename Policy, std::ranges::random_access_range Range, typename Functor>
+	void visitRange(Policy&& executor, Range&& range, Functor func, std::size_t chunkSize = 0);
+
+	// Appends every element of range to buffer, the same bytes as serializing them one after another. Chunks are serialized into buffers of their own and concatenated without locking.
+	template <typename Policy, std::ranges::random_access_range Range, ByteBuffer Buffer>
+	void serializeRange(Policy&& executor, Range const& range, Buffer& buffer, std::size_t chunkSize = 0);
+
+	// Bit set returned by bulk comparisons, bit i is set if element i matched.
+	class Bitmask;
+
+	// Replaces every element of column Name with func(element).
+	template <FixedString Name, typename T, typename Functor>
+	void transform(SoaVector<T>& soa, Functor&& func);
+
+	// Combines every element of column Name with init using op, which must be associative and commutative like std::reduce.
+	template <FixedString Name, typename T, typename U, typename BinaryOp = std::plus<>>
+	U reduce(SoaVector<T> const& soa, U init, BinaryOp op = {});
+
+	// Sets bit i for every element i of column Name equal to value, which must convert to the column type without narrowing.
+	template <FixedString Name, typename T, typename U>
+	Bitmask compareEq(SoaVector<T> const& soa, U const& value);
+
+	// Arrow style column holding one leaf of a batch of objects, see toColumns.
+	struct Column {
+		std::string_view name;				// Dotted name of the leaf, pt1.x
+		std::string_view format;			// Arrow C data interface format string, "f" for float, "U" for strings, "w:12" for other trivially copyable leaves.
+		std::uint64_t typeId;
+		std::size_t nullCount = 0;
+		std::vector<std::uint8_t> validity;	// Bit i is set unless row i is null, least significant bit first.
+		std::vector<std::byte> values;		// Fixed width values, one bit per row for bool, the characters of every row for strings.
+		std::vector<std::int64_t> offsets;	// rows + 1 offsets of every string into values, empty for other leaves.
+	};
+
+	struct ColumnBatch {
+		std::size_t rows = 0;
+		std::vector<Column> columns;
+	};
+
+	/*!***********************************************************************
+	* @brief
+	*	Converts rows into a column per leaf, in a single pass over the rows
+	*	into buffers sized from the row count. The buffers use the Arrow
+	*	layouts: fixed width values, bit packed bools, and 64 bit offsets
+	*	followed by characters for strings (large_utf8). Leaves that are
+	*	std::optional set nullCount and clear validity bits for empty rows,
+	*	every other row is valid.
+	*
+	*	Leaves must be arithmetic, enums, strings, trivially copyable or a
+	*	std::optional of those.
+	**************************************************************************/
+	template <typename T>
+	ColumnBatch toColumns(std::span<T const> rows);
+
+	// Reads a batch written by toColumns back into rows, which must hold batch.rows objects. Returns false if the columns don't match the leaves of T.
+	template <typename T>
+	bool fromColumns(ColumnBatch const& batch, std::span<T> rows);
+
+	namespace registry {
+		struct TypeDescriptor;
+
+		// Type erased data member. get and set copy the data member out of and into an object, they are null if it isn't copy assignable.
+		struct FieldDescriptor {
+			std::string_view name;
+			std::size_t offset;
+			std::size_t size;
+			std::uint64_t typeId;
+			TypeDescriptor const* type;							// Descriptor of the data member if it is reflectable, null otherwise.
+			void* (*address)(void* object);
+			void (*get)(void const* object, void* destination);
+			void (*set)(void* object, void const* source);
+
+			// Pointer to the data member of object if it is of type U, null otherwise.
+			template <typename U>
+			U* as(void* object) const;
+
+			template <typename U>
+			U const* as(void const* object) const;
+		};
+
+		// Type erased reflectable class. construct and destroy are null if the class isn't default constructible or destructible.
+		struct TypeDescriptor {
+			std::string_view name;
+			std::uint64_t typeId;
+			std::size_t size;
+			std::size_t alignment;
+			std::span<FieldDescriptor const> fields;
+			std::size_t (*findField)(std::string_view name);
+			void (*construct)(void* storage);
+			void (*destroy)(void* object);
+
+			// Descriptor of the data member called name, null if there is none.
+			FieldDescriptor const* field(std::string_view name) const;
+		};
+
+		/*!***********************************************************************
+		* @brief
+		*	Descriptor table of T, built at compile time so it needs no
+		*	initialization and is safe to read from any thread.
+		**************************************************************************/
+		template <typename T>
+		constexpr TypeDescriptor const& describe();
+
+		/*!***********************************************************************
+		* @brief
+		*	Makes the descriptors of Ts, and of the reflectable data members they
+		*	contain, findable by type id and type name. Meant to be called once
+		*	per type at startup or when a plugin is loaded, it copies the lookup
+		*	table so find never has to lock. Safe to call from any thread.
+		**************************************************************************/
+		template <typename... Ts>
+		void add();
+
+		// Descriptor of the added type with this typeId, null if there is none. Lock free.
+		TypeDescriptor const* find(std::uint64_t typeId);
+
+		// Descriptor of the added type called typeName, as spelled by typeName<T>(). Lock free.
+		TypeDescriptor const* find(std::string_view typeName);
+
+		// Every added type in the order they were added. Lock free, the span stays valid for the lifetime of the program.
+		std::span<TypeDescriptor const* const> types();
+	}
+
+	/*!***********************************************************************
+	* @brief
+	*	Counters of visit, serialize and deserialize, enabled by defining
+	*	REFLECTION_INSTRUMENTATION before including reflection.hpp. Every
+	*	reflected type and data member that is used gets a call count, the
+	*	cycles spent and the bytes processed, kept per thread without locks.
+	*	Without the define the hooks are empty and snapshot returns nothing.
+	**************************************************************************/
+	namespace instrumentation {
+#if defined(REFLECTION_INSTRUMENTATION)
+		inline constexpr bool enabled = true;
+#else
+		inline constexpr bool enabled = false;
+#endif
+
+		enum class Operation : std::uint8_t {
+			visit,
+			serialize,
+			deserialize
+		};
+
+		struct Counter {
+			Operation operation;
+			std::string_view type;		// typeName of the reflected class.
+			std::string_view field;		// data member for visit, dotted leaf name for the serializers, empty for the class as a whole.
+			std::uint64_t calls;
+			std::uint64_t cycles;		// time stamp counter ticks, steady_clock nanoseconds where there is none.
+			std::uint64_t bytes;
+		};
+
+		/*!***********************************************************************
+		* @brief
+		*	Totals of every thread so far, one counter per operation, type and
+		*	data member. Counters of classes include their nested reflectable
+		*	data members. The serializers count leaves that aren't copied with
+		*	memcpy on their own, contiguous trivially copyable leaves are only
+		*	counted as part of their class. Safe to call while other threads
+		*	are counting, their latest increments may be missing.
+		**************************************************************************/
+		std::vector<Counter> snapshot();
+	}
+}
+
+/*!========================================================================
+	Implementation details..
+========================================================================*/
+// Supports up to 256 data members. REFLECTION_APPLY_MACRO_TO_EACH_EXPAND rescans its argument 21 times and every rescan applies the macro
+// to 16 more arguments (room for 336). The number of rescans is fixed, so expansion cost grows linearly with argument count.
+#define REFLECTION_MAX_REFLECTED_FIELDS 256
+
+#define REFLECTION_COUNT_EACH(dataMember, index) + 1
+#define REFLECTION_COUNT_ARGS(...) (0 REFLECTION_APPLY_MACRO_TO_EACH(REFLECTION_COUNT_EACH, __VA_ARGS__))
+
+#define REFLECTION_CONCATENATE(a, b) REFLECTION_CONCATENATE_IMPL(a, b)
+#define REFLECTION_CONCATENATE_IMPL(a, b) a##b
+
+// Increments a literal index without building ever growing 0 + 1 + 1 + ... expressions.
+#define REFLECTION_INCREMENT(index) REFLECTION_CONCATENATE(REFLECTION_INCREMENT_, index)
+#define REFLECTION_INCREMENT_0 1
+#define REFLECTION_INCREMENT_1 2
+#define REFLECTION_INCREMENT_2 3
+#define REFLECTION_INCREMENT_3 4
+#define REFLECTION_INCREMENT_4 5
+#define REFLECTION_INCREMENT_5 6
+#define REFLECTION_INCREMENT_6 7
+#define REFLECTION_INCREMENT_7 8
+#define REFLECTION_INCREMENT_8 9
+#define REFLECTION_INCREMENT_9 10
+#define REFLECTION_INCREMENT_10 11
+#define REFLECTION_INCREMENT_11 12
+#define REFLECTION_INCREMENT_12 13
+#define REFLECTION_INCREMENT_13 14
+#define REFLECTION_INCREMENT_14 15
+#define REFLECTION_INCREMENT_15 16
+#define REFLECTION_INCREMENT_16 17
+#define REFLECTION_INCREMENT_17 18
+#define REFLECTION_INCREMENT_18 19
+#define REFLECTION_INCREMENT_19 20
+#define REFLECTION_INCREMENT_20 21
+#define REFLECTION_INCREMENT_21 22
+#define REFLECTION_INCREMENT_22 23
+#define REFLECTION_INCREMENT_23 24
+#define REFLECTION_INCREMENT_24 25
+#define REFLECTION_INCREMENT_25 26
+#define REFLECTION_INCREMENT_26 27
+#define REFLECTION_INCREMENT_27 28
+#define REFLECTION_INCREMENT_28 29
+#define REFLECTION_INCREMENT_29 30
+#define REFLECTION_INCREMENT_30 31
+#define REFLECTION_INCREMENT_31 32
+#define REFLECTION_INCREMENT_32 33
+#define REFLECTION_INCREMENT_33 34
+#define REFLECTION_INCREMENT_34 35
+#define REFLECTION_INCREMENT_35 36
+#define REFLECTION_INCREMENT_36 37
+#define REFLECTION_INCREMENT_37 38
+#define REFLECTION_INCREMENT_38 39
+#define REFLECTION_INCREMENT_39 40
+#define REFLECTION_INCREMENT_40 41
+#define REFLECTION_INCREMENT_41 42
+#define REFLECTION_INCREMENT_42 43
+#define REFLECTION_INCREMENT_43 44
+#define REFLECTION_INCREMENT_44 45
+#define REFLECTION_INCREMENT_45 46
+#define REFLECTION_INCREMENT_46 47
+#define REFLECTION_INCREMENT_47 48
+#define REFLECTION_INCREMENT_48 49
+#define REFLECTION_INCREMENT_49 50
+#define REFLECTION_INCREMENT_50 51
+#define REFLECTION_INCREMENT_51 52
+#define REFLECTION_INCREMENT_52 53
+#define REFLECTION_INCREMENT_53 54
+#define REFLECTION_INCREMENT_54 55
+#define REFLECTION_INCREMENT_55 56
+#define REFLECTION_INCREMENT_56 57
+#define REFLECTION_INCREMENT_57 58
+#define REFLECTION_INCREMENT_58 59
+#define REFLECTION_INCREMENT_59 60
+#define REFLECTION_INCREMENT_60 61
+#define REFLECTION_INCREMENT_61 62
+#define REFLECTION_INCREMENT_62 63
+#define REFLECTION_INCREMENT_63 64
+#define REFLECTION_INCREMENT_64 65
+#define REFLECTION_INCREMENT_65 66
+#define REFLECTION_INCREMENT_66 67
+#define REFLECTION_INCREMENT_67 68
+#define REFLECTION_INCREMENT_68 69
+#define REFLECTION_INCREMENT_69 70
+#define REFLECTION_INCREMENT_70 71
+#define REFLECTION_INCREMENT_71 72
+#define REFLECTION_INCREMENT_72 73
+#define REFLECTION_INCREMENT_73 74
+#define REFLECTION_INCREMENT_74 75
+#define REFLECTION_INCREMENT_75 76
+#define REFLECTION_INCREMENT_76 77
+#define REFLECTION_INCREMENT_77 78
+#define REFLECTION_INCREMENT_78 79
+#define REFLECTION_INCREMENT_79 80
+#define REFLECTION_INCREMENT_80 81
+#define REFLECTION_INCREMENT_81 82
+#define REFLECTION_INCREMENT_82 83
+#define REFLECTION_INCREMENT_83 84
+#define REFLECTION_INCREMENT_84 85
+#define REFLECTION_INCREMENT_85 86
+#define REFLECTION_INCREMENT_86 87
+#define REFLECTION_INCREMENT_87 88
+#define REFLECTION_INCREMENT_88 89
+#define REFLECTION_INCREMENT_89 90
+#define REFLECTION_INCREMENT_90 91
+#define REFLECTION_INCREMENT_91 92
+#define REFLECTION_INCREMENT_92 93
+#define REFLECTION_INCREMENT_93 94
+#define REFLECTION_INCREMENT_94 95
+#define REFLECTION_INCREMENT_95 96
+#define REFLECTION_INCREMENT_96 97
+#define REFLECTION_INCREMENT_97 98
+#define REFLECTION_INCREMENT_98 99
+#define REFLECTION_INCREMENT_99 100
+#define REFLECTION_INCREMENT_100 101
+#define REFLECTION_INCREMENT_101 102
+#define REFLECTION_INCREMENT_102 103
+#define REFLECTION_INCREMENT_103 104
+#define REFLECTION_INCREMENT_104 105
+#define REFLECTION_INCREMENT_105 106
+#define REFLECTION_INCREMENT_106 107
+#define REFLECTION_INCREMENT_107 108
+#define REFLECTION_INCREMENT_108 109
+#define REFLECTION_INCREMENT_109 110
+#define REFLECTION_INCREMENT_110 111
+#define REFLECTION_INCREMENT_111 112
+#define REFLECTION_INCREMENT_112 113
+#define REFLECTION_INCREMENT_113 114
+#define REFLECTION_INCREMENT_114 115
+#define REFLECTION_INCREMENT_115 116
+#define REFLECTION_INCREMENT_116 117
+#define REFLECTION_INCREMENT_117 118
+#define REFLECTION_INCREMENT_118 119
+#define REFLECTION_INCREMENT_119 120
+#define REFLECTION_INCREMENT_120 121
+#define REFLECTION_INCREMENT_121 122
+#define REFLECTION_INCREMENT_122 123
+#define REFLECTION_INCREMENT_123 124
+#define REFLECTION_INCREMENT_124 125
+#define REFLECTION_INCREMENT_125 126
+#define REFLECTION_INCREMENT_126 127
+#define REFLECTION_INCREMENT_127 128
+#define REFLECTION_INCREMENT_128 129
+#define REFLECTION_INCREMENT_129 130
+#define REFLECTION_INCREMENT_130 131
+#define REFLECTION_INCREMENT_131 132
+#define REFLECTION_INCREMENT_132 133
+#define REFLECTION_INCREMENT_133 134
+#define REFLECTION_INCREMENT_134 135
+#define REFLECTION_INCREMENT_135 136
+#define REFLECTION_INCREMENT_136 137
+#define REFLECTION_INCREMENT_137 138
+#define REFLECTION_INCREMENT_138 139
+#define REFLECTION_INCREMENT_139 140
+#define REFLECTION_INCREMENT_140 141
+#define REFLECTION_INCREMENT_141 142
+#define REFLECTION_INCREMENT_142 143
+#define REFLECTION_INCREMENT_143 144
+#define REFLECTION_INCREMENT_144 145
+#define REFLECTION_INCREMENT_145 146
+#define REFLECTION_INCREMENT_146 147
+#define REFLECTION_INCREMENT_147 148
+#define REFLECTION_INCREMENT_148 149
+#define REFLECTION_INCREMENT_149 150
+#define REFLECTION_INCREMENT_150 151
+#define REFLECTION_INCREMENT_151 152
+#define REFLECTION_INCREMENT_152 153
+#define REFLECTION_INCREMENT_153 154
+#define REFLECTION_INCREMENT_154 155
+#define REFLECTION_INCREMENT_155 156
+#define REFLECTION_INCREMENT_156 157
+#define REFLECTION_INCREMENT_157 158
+#define REFLECTION_INCREMENT_158 159
+#define REFLECTION_INCREMENT_159 160
+#define REFLECTION_INCREMENT_160 161
+#define REFLECTION_INCREMENT_161 162
+#define REFLECTION_INCREMENT_162 163
+#define REFLECTION_INCREMENT_163 164
+#define REFLECTION_INCREMENT_164 165
+#define REFLECTION_INCREMENT_165 166
+#define REFLECTION_INCREMENT_166 167
+#define REFLECTION_INCREMENT_167 168
+#define REFLECTION_INCREMENT_168 169
+#define REFLECTION_INCREMENT_169 170
+#define REFLECTION_INCREMENT_170 171
+#define REFLECTION_INCREMENT_171 172
+#define REFLECTION_INCREMENT_172 173
+#define REFLECTION_INCREMENT_173 174
+#define REFLECTION_INCREMENT_174 175
+#define REFLECTION_INCREMENT_175 176
+#define REFLECTION_INCREMENT_176 177
+#define REFLECTION_INCREMENT_177 178
+#define REFLECTION_INCREMENT_178 179
+#define REFLECTION_INCREMENT_179 180
+#define REFLECTION_INCREMENT_180 181
+#define REFLECTION_INCREMENT_181 182
+#define REFLECTION_INCREMENT_182 183
+#define REFLECTION_INCREMENT_183 184
+#define REFLECTION_INCREMENT_184 185
+#define REFLECTION_INCREMENT_185 186
+#define REFLECTION_INCREMENT_186 187
+#define REFLECTION_INCREMENT_187 188
+#define REFLECTION_INCREMENT_188 189
+#define REFLECTION_INCREMENT_189 190
+#define REFLECTION_INCREMENT_190 191
+#define REFLECTION_INCREMENT_191 192
+#define REFLECTION_INCREMENT_192 193
+#define REFLECTION_INCREMENT_193 194
+#define REFLECTION_INCREMENT_194 195
+#define REFLECTION_INCREMENT_195 196
+#define REFLECTION_INCREMENT_196 197
+#define REFLECTION_INCREMENT_197 198
+#define REFLECTION_INCREMENT_198 199
+#define REFLECTION_INCREMENT_199 200
+#define REFLECTION_INCREMENT_200 201
+#define REFLECTION_INCREMENT_201 202
+#define REFLECTION_INCREMENT_202 203
+#define REFLECTION_INCREMENT_203 204
+#define REFLECTION_INCREMENT_204 205
+#define REFLECTION_INCREMENT_205 206
+#define REFLECTION_INCREMENT_206 207
+#define REFLECTION_INCREMENT_207 208
+#define REFLECTION_INCREMENT_208 209
+#define REFLECTION_INCREMENT_209 210
+#define REFLECTION_INCREMENT_210 211
+#define REFLECTION_INCREMENT_211 212
+#define REFLECTION_INCREMENT_212 213
+#define REFLECTION_INCREMENT_213 214
+#define REFLECTION_INCREMENT_214 215
+#define REFLECTION_INCREMENT_215 216
+#define REFLECTION_INCREMENT_216 217
+#define REFLECTION_INCREMENT_217 218
+#define REFLECTION_INCREMENT_218 219
+#define REFLECTION_INCREMENT_219 220
+#define REFLECTION_INCREMENT_220 221
+#define REFLECTION_INCREMENT_221 222
+#define REFLECTION_INCREMENT_222 223
+#define REFLECTION_INCREMENT_223 224
+#define REFLECTION_INCREMENT_224 225
+#define REFLECTION_INCREMENT_225 226
+#define REFLECTION_INCREMENT_226 227
+#define REFLECTION_INCREMENT_227 228
+#define REFLECTION_INCREMENT_228 229
+#define REFLECTION_INCREMENT_229 230
+#define REFLECTION_INCREMENT_230 231
+#define REFLECTION_INCREMENT_231 232
+#define REFLECTION_INCREMENT_232 233
+#define REFLECTION_INCREMENT_233 234
+#define REFLECTION_INCREMENT_234 235
+#define REFLECTION_INCREMENT_235 236
+#define REFLECTION_INCREMENT_236 237
+#define REFLECTION_INCREMENT_237 238
+#define REFLECTION_INCREMENT_238 239
+#define REFLECTION_INCREMENT_239 240
+#define REFLECTION_INCREMENT_240 241
+#define REFLECTION_INCREMENT_241 242
+#define REFLECTION_INCREMENT_242 243
+#define REFLECTION_INCREMENT_243 244
+#define REFLECTION_INCREMENT_244 245
+#define REFLECTION_INCREMENT_245 246
+#define REFLECTION_INCREMENT_246 247
+#define REFLECTION_INCREMENT_247 248
+#define REFLECTION_INCREMENT_248 249
+#define REFLECTION_INCREMENT_249 250
+#define REFLECTION_INCREMENT_250 251
+#define REFLECTION_INCREMENT_251 252
+#define REFLECTION_INCREMENT_252 253
+#define REFLECTION_INCREMENT_253 254
+#define REFLECTION_INCREMENT_254 255
+#define REFLECTION_INCREMENT_255 256
+
+#define REFLECTION_PARENTHESES ()
+#define REFLECTION_APPLY_MACRO_TO_EACH_EXPAND(...) REFLECTION_EXPAND_4(REFLECTION_EXPAND_4(REFLECTION_EXPAND_4(REFLECTION_EXPAND_4(__VA_ARGS__))))
+#define REFLECTION_EXPAND_4(...) REFLECTION_EXPAND_1(REFLECTION_EXPAND_1(REFLECTION_EXPAND_1(REFLECTION_EXPAND_1(__VA_ARGS__))))
+#define REFLECTION_EXPAND_1(...) __VA_ARGS__
+
+// Applies macro for each variadic argument. Every step applies it to 16 arguments, then defers to the next step which gets picked up by the following rescan.
+#define REFLECTION_APPLY_MACRO_TO_EACH(macro, ...) __VA_OPT__(REFLECTION_APPLY_MACRO_TO_EACH_EXPAND(REFLECTION_APPLY_MACRO_TO_EACH_1(macro, 0, __VA_ARGS__)))
+#define REFLECTION_APPLY_MACRO_TO_EACH_AGAIN() REFLECTION_APPLY_MACRO_TO_EACH_1
+#define REFLECTION_APPLY_MACRO_TO_EACH_1(macro, index, a, ...)	macro(a, index) __VA_OPT__(REFLECTION_APPLY_MACRO_TO_EACH_2(macro, REFLECTION_INCREMENT(index), __VA_ARGS__))
+#define REFLECTION_APPLY_MACRO_TO_EACH_2(macro, index, a, ...)	macro(a, index) __VA_OPT__(REFLECTION_APPLY_MACRO_TO_EACH_3(macro, REFLECTION_INCREMENT(index), __VA_ARGS__))
+#define REFLECTION_APPLY_MACRO_TO_EACH_3(macro, index, a, ...)	macro(a, index) __VA_OPT__(REFLECTION_APPLY_MACRO_TO_EACH_4(macro, REFLECTION_INCREMENT(index), __VA_ARGS__))
+#define REFLECTION_APPLY_MACRO_TO_EACH_4(macro, index, a, ...)	macro(a, index) __VA_OPT__(REFLECTION_APPLY_MACRO_TO_EACH_5(macro, REFLECTION_INCREMENT(index), __VA_ARGS__))
+#define REFLECTION_APPLY_MACRO_TO_EACH_5(macro, index, a, ...)	macro(a, index) __VA_OPT__(REFLECTION_APPLY_MACRO_TO_EACH_6(macro, REFLECTION_INCREMENT(index), __VA_ARGS__))
+#define REFLECTION_APPLY_MACRO_TO_EACH_6(macro, index, a, ...)	macro(a, index) __VA_OPT__(REFLECTION_APPLY_MACRO_TO_EACH_7(macro, REFLECTION_INCREMENT(index), __VA_ARGS__))
+#define REFLECTION_APPLY_MACRO_TO_EACH_7(macro, index, a, ...)	macro(a, index) __VA_OPT__(REFLECTION_APPLY_MACRO_TO_EACH_8(macro, REFLECTION_INCREMENT(index), __VA_ARGS__))
+#define REFLECTION_APPLY_MACRO_TO_EACH_8(macro, index, a, ...)	macro(a, index) __VA_OPT__(REFLECTION_APPLY_MACRO_TO_EACH_9(macro, REFLECTION_INCREMENT(index), __VA_ARGS__))
+#define REFLECTION_APPLY_MACRO_TO_EACH_9(macro, index, a, ...)	macro(a, index) __VA_OPT__(REFLECTION_APPLY_MACRO_TO_EACH_10(macro, REFLECTION_INCREMENT(index), __VA_ARGS__))
+#define REFLECTION_APPLY_MACRO_TO_EACH_10(macro, index, a, ...)	macro(a, index) __VA_OPT__(REFLECTION_APPLY_MACRO_TO_EACH_11(macro, REFLECTION_INCREMENT(index), __VA_ARGS__))
+#define REFLECTION_APPLY_MACRO_TO_EACH_11(macro, index, a, ...)	macro(a, index) __VA_OPT__(REFLECTION_APPLY_MACRO_TO_EACH_12(macro, REFLECTION_INCREMENT(index), __VA_ARGS__))
+#define REFLECTION_APPLY_MACRO_TO_EACH_12(macro, index, a, ...)	macro(a, index) __VA_OPT__(REFLECTION_APPLY_MACRO_TO_EACH_13(macro, REFLECTION_INCREMENT(index), __VA_ARGS__))
+#define REFLECTION_APPLY_MACRO_TO_EACH_13(macro, index, a, ...)	macro(a, index) __VA_OPT__(REFLECTION_APPLY_MACRO_TO_EACH_14(macro, REFLECTION_INCREMENT(index), __VA_ARGS__))
+#define REFLECTION_APPLY_MACRO_TO_EACH_14(macro, index, a, ...)	macro(a, index) __VA_OPT__(REFLECTION_APPLY_MACRO_TO_EACH_15(macro, REFLECTION_INCREMENT(index), __VA_ARGS__))
+#define REFLECTION_APPLY_MACRO_TO_EACH_15(macro, index, a, ...)	macro(a, index) __VA_OPT__(REFLECTION_APPLY_MACRO_TO_EACH_16(macro, REFLECTION_INCREMENT(index), __VA_ARGS__))
+#define REFLECTION_APPLY_MACRO_TO_EACH_16(macro, index, a, ...)	macro(a, index) __VA_OPT__(REFLECTION_APPLY_MACRO_TO_EACH_AGAIN REFLECTION_PARENTHESES (macro, REFLECTION_INCREMENT(index), __VA_ARGS__))
+
+/*!***********************************************************************
+* @brief
+*	The macro responsible for static reflection. It generates metadata for every data member.
+*	Please take a look at the Reflection.hpp file level documentation if you want
+*	to understand the implementation details behind reflection.
+*
+* @param [in] ...					: Variadic argument list, containing all of the data members you want to reflect.
+*
+**************************************************************************/
+#define REFLECTABLE(...) \
+static int constexpr _reflection_fields_n = REFLECTION_COUNT_ARGS(__VA_ARGS__); \
+friend reflection::query; \
+static_assert(_reflection_fields_n <= REFLECTION_MAX_REFLECTED_FIELDS, "Reflection does not support more than 256 data members."); \
+template<int N, typename Object> \
+struct FieldData {}; \
+REFLECTION_APPLY_MACRO_TO_EACH(REFLECTION_EACH, __VA_ARGS__) \
+
+// offsetof on non standard layout classes is conditionally supported, GCC and Clang support it but warn about it.
+#if defined(__GNUC__) || defined(__clang__)
+	#define REFLECTION_OFFSETOF_WARNING_BEGIN _Pragma("GCC diagnostic push") _Pragma("GCC diagnostic ignored \"-Winvalid-offsetof\"")
+	#define REFLECTION_OFFSETOF_WARNING_END _Pragma("GCC diagnostic pop")
+#else
+	#define REFLECTION_OFFSETOF_WARNING_BEGIN
+	#define REFLECTION_OFFSETOF_WARNING_END
+#endif
+
+// Annotates a data member in REFLECTABLE with attributes from reflection::attributes, REFLECTABLE(x, ATTR(y, varint, fixedWidth<2>)).
+// ATTR is left undefined if something else already defines it, REFLECTION_ATTR works either way.
+#define REFLECTION_ATTR(dataMember, ...) (dataMember, __VA_ARGS__)
+
+#if !defined(ATTR)
+	#define ATTR REFLECTION_ATTR
+#endif
+
+// 1 if the argument is parenthesized, which REFLECTION_ATTR makes it, 0 otherwise.
+#define REFLECTION_IS_ANNOTATED(argument) REFLECTION_SECOND_ARGUMENT(REFLECTION_ANNOTATED_PROBE argument, 0, )
+#define REFLECTION_ANNOTATED_PROBE(...) ~, 1,
+#define REFLECTION_SECOND_ARGUMENT(...) REFLECTION_SECOND_ARGUMENT_IMPL(__VA_ARGS__)
+#define REFLECTION_SECOND_ARGUMENT_IMPL(first, second, ...) second
+
+#define REFLECTION_UNWRAP(...) __VA_ARGS__
+#define REFLECTION_EACH(argument, index) REFLECTION_CONCATENATE(REFLECTION_EACH_, REFLECTION_IS_ANNOTATED(argument))(argument, index)
+#define REFLECTION_EACH_0(dataMember, index) REFLECTION_FIELD(dataMember, index)
+#define REFLECTION_EACH_1(annotated, index) REFLECTION_ANNOTATED(index, REFLECTION_UNWRAP annotated)
+#define REFLECTION_ANNOTATED(index, ...) REFLECTION_ANNOTATED_IMPL(index, __VA_ARGS__)
+#define REFLECTION_ANNOTATED_IMPL(index, dataMember, ...) REFLECTION_FIELD(dataMember, index, __VA_ARGS__)
+
+#define REFLECTION_FIELD(dataMember, index, ...) \
+\
+template<typename Object> \
+struct FieldData<index, Object> \
+{ \
+	using type = std::remove_cvref_t<decltype(std::decay_t<Object>::dataMember)>; \
+\
+    Object&& self; \
+\
+    constexpr FieldData(Object&& self) : self(static_cast<Object&&>(self)) {} \
+    \
+    constexpr auto& get() const \
+    {\
+        return self.dataMember; \
+    }\
+    static constexpr char const* name() \
+    {\
+        return #dataMember; \
+    }\
+	static constexpr decltype(auto) getPointerToMember() { \
+		return &std::decay_t<Object>::dataMember;	\
+	}\
+	static constexpr reflection::FieldAttributes attributes() { \
+		__VA_OPT__(using namespace reflection::attributes;) \
+		return reflection::FieldAttributes{ __VA_ARGS__ }; \
+	}\
+	REFLECTION_OFFSETOF_WARNING_BEGIN \
+	static constexpr std::size_t offset() { \
+		return offsetof(std::decay_t<Object>, dataMember); \
+	}\
+	REFLECTION_OFFSETOF_WARNING_END \
+}; \
+
+/*!========================================================================
+	Instrumentation
+========================================================================*/
+namespace reflection {
+#if defined(REFLECTION_INSTRUMENTATION)
+	inline std::uint64_t _internal_timestamp() {
+	#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+		return __rdtsc();
+	#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+		std::uint64_t ticks;
+		asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+		return ticks;
+	#else
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+	#endif
+	}
+
+	// Fixed number of pages allocated on first use, slots never move so other threads can read them without locks.
+	template <typename Slot>
+	class _internal_Pages {
+	public:
+		static constexpr std::size_t pageSize = 64;
+		static constexpr std::size_t capacity = pageSize * 1024;
+
+		_internal_Pages() = default;
+		_internal_Pages(_internal_Pages const&) = delete;
+		_internal_Pages& operator=(_internal_Pages const&) = delete;
+
+		~_internal_Pages() {
+			for (std::atomic<Slot*>& page : pages) {
+				delete[] page.load(std::memory_order_relaxed);
+			}
+		}
+
+		Slot& operator[](std::size_t index) {
+			std::atomic<Slot*>& page = pages[index / pageSize];
+			Slot* slots = page.load(std::memory_order_acquire);
+
+			if (!slots) {
+				Slot* fresh = new Slot[pageSize] {};
+
+				if (page.compare_exchange_strong(slots, fresh, std::memory_order_acq_rel)) {
+					slots = fresh;
+				}
+				else {
+					delete[] fresh;
+				}
+			}
+
+			return slots[index % pageSize];
+		}
+
+		// Null if the page of index wasn't allocated yet.
+		Slot const* find(std::size_t index) const {
+			Slot const* slots = pages[index / pageSize].load(std::memory_order_acquire);
+			return slots ? slots + index % pageSize : nullptr;
+		}
+
+	private:
+		std::array<std::atomic<Slot*>, capacity / pageSize> pages {};
+	};
+
+	// Operation, type and data member that counters are kept for.
+	struct _internal_Site {
+		instrumentation::Operation operation {};
+		std::string_view type;
+		std::string_view field;
+		std::atomic<bool> ready { false };
+	};
+
+	struct _internal_CounterSlot {
+		std::atomic<std::uint64_t> calls { 0 };
+		std::atomic<std::uint64_t> cycles { 0 };
+		std::atomic<std::uint64_t> bytes { 0 };
+	};
+
+	struct _internal_ThreadCounters {
+		_internal_Pages<_internal_CounterSlot> slots;
+		std::atomic<bool> inUse { true };
+		_internal_ThreadCounters* next = nullptr;
+	};
+
+	struct _internal_Instrumentation {
+		_internal_Pages<_internal_Site> sites;
+		std::atomic<std::size_t> siteCount { 0 };
+		std::atomic<_internal_ThreadCounters*> threads { nullptr };
+	};
+
+	// Never destroyed, threads may still count while static objects are destroyed.
+	inline _internal_Instrumentation& _internal_instrumentation() {
+		static _internal_Instrumentation& instrumentation = *new _internal_Instrumentation;
+		return instrumentation;
+	}
+
+	inline constexpr std::size_t _internal_noSite = std::numeric_limits<std::size_t>::max();
+
+	inline std::size_t _internal_addSite(instrumentation::Operation operation, std::string_view type, std::string_view field) {
+		_internal_Instrumentation& instrumentation = _internal_instrumentation();
+		std::size_t const index = instrumentation.siteCount.fetch_add(1, std::memory_order_relaxed);
+
+		if (index >= _internal_Pages<_internal_Site>::capacity) {
+			return _internal_noSite;
+		}
+
+		_internal_Site& site = instrumentation.sites[index];
+		site.operation = operation;
+		site.type = type;
+		site.field = field;
+		site.ready.store(true, std::memory_order_release);
+
+		return index;
+	}
+
+	// Field is the FieldData or LeafField counted, void for the class as a whole.
+	template <instrumentation::Operation Operation, typename T, typename Field>
+	std::size_t _internal_siteIndex() {
+		static std::size_t const index = [] {
+			if constexpr (std::is_void_v<Field>) {
+				return _internal_addSite(Operation, typeName<T>(), {});
+			}
+			else {
+				return _internal_addSite(Operation, typeName<T>(), Field::name());
+			}
+		}();
+
+		return index;
+	}
+
+	// Counters of threads that exited are taken over by new threads rather than freed, so snapshot never reads freed memory.
+	inline _internal_ThreadCounters* _internal_claimCounters() {
+		_internal_Instrumentation& instrumentation = _internal_instrumentation();
+
+		for (_internal_ThreadCounters* counters = instrumentation.threads.load(std::memory_order_acquire); counters; counters = counters->next) {
+			bool expected = false;
+
+			if (counters->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+				return counters;
+			}
+		}
+
+		_internal_ThreadCounters* counters = new _internal_ThreadCounters;
+		counters->next = instrumentation.threads.load(std::memory_order_relaxed);
+
+		while (!instrumentation.threads.compare_exchange_weak(counters->next, counters, std::memory_order_release, std::memory_order_relaxed)) {}
+
+		return counters;
+	}
+
+	inline _internal_ThreadCounters& _internal_threadCounters() {
+		struct Owner {
+			_internal_ThreadCounters* counters = _internal_claimCounters();
+
+			~Owner() {
+				counters->inUse.store(false, std::memory_order_release);
+			}
+		};
+
+		thread_local Owner owner;
+		return *owner.counters;
+	}
+
+	inline void _internal_count(std::size_t site, std::uint64_t cycles, std::uint64_t bytes) {
+		if (site == _internal_noSite) {
+			return;
+		}
+
+		_internal_CounterSlot& slot = _internal_threadCounters().slots[site];
+
+		// only the owning thread writes, so there is no need for read modify write operations.
+		slot.calls.store(slot.calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		slot.cycles.store(slot.cycles.load(std::memory_order_relaxed) + cycles, std::memory_order_relaxed);
+		slot.bytes.store(slot.bytes.load(std::memory_order_relaxed) + bytes, std::memory_order_relaxed);
+	}
+
+	template <typename IO>
+	std::uint64_t _internal_processed(void const* io) {
+		return static_cast<IO const*>(io)->processed();
+	}
+
+	// Counts the scope it lives in, with the bytes an optional reader or writer processed meanwhile. Does nothing during constant evaluation.
+	template <instrumentation::Operation Operation, typename T, typename Field = void>
+	class _internal_Probe {
+	public:
+		constexpr _internal_Probe() {
+			if (!std::is_constant_evaluated()) {
+				start = _internal_timestamp();
+			}
+		}
+
+		template <typename IO>
+		constexpr explicit _internal_Probe(IO const& io) : processed{ &_internal_processed<IO> }, io{ &io } {
+			if (!std::is_constant_evaluated()) {
+				startBytes = io.processed();
+				start = _internal_timestamp();
+			}
+		}
+
+		_internal_Probe(_internal_Probe const&) = delete;
+		_internal_Probe& operator=(_internal_Probe const&) = delete;
+
+		constexpr ~_internal_Probe() {
+			if (!std::is_constant_evaluated()) {
+				std::uint64_t const cycles = _internal_timestamp() - start;
+				_internal_count(_internal_siteIndex<Operation, T, Field>(), cycles, io ? processed(io) - startBytes : 0);
+			}
+		}
+
+	private:
+		std::uint64_t start = 0;
+		std::uint64_t startBytes = 0;
+		std::uint64_t (*processed)(void const*) = nullptr;
+		void const* io = nullptr;
+	};
+
+	namespace instrumentation {
+		inline std::vector<Counter> snapshot() {
+			_internal_Instrumentation& instrumentation = _internal_instrumentation();
+			std::size_t const siteCount = std::min(instrumentation.siteCount.load(std::memory_order_acquire), _internal_Pages<_internal_Site>::capacity);
+
+			std::vector<Counter> counters;
+
+			for (std::size_t index = 0; index < siteCount; ++index) {
+				_internal_Site const* site = instrumentation.sites.find(index);
+
+				if (!site || !site->ready.load(std::memory_order_acquire)) {
+					continue;
+				}
+
+				Counter counter { site->operation, site->type, site->field, 0, 0, 0 };
+
+				for (_internal_ThreadCounters* threads = instrumentation.threads.load(std::memory_order_acquire); threads; threads = threads->next) {
+					if (_internal_CounterSlot const* slot = threads->slots.find(index)) {
+						counter.calls += slot->calls.load(std::memory_order_relaxed);
+						counter.cycles += slot->cycles.load(std::memory_order_relaxed);
+						counter.bytes += slot->bytes.load(std::memory_order_relaxed);
+					}
+				}
+
+				if (counter.calls == 0) {
+					continue;
+				}
+
+				// const and non const objects, or different readers and writers, count the same data member at different sites.
+				auto const same = std::ranges::find_if(counters, [&](Counter const& other) {
+					return other.operation == counter.operation && other.type == counter.type && other.field == counter.field;
+				});
+
+				if (same == counters.end()) {
+					counters.push_back(counter);
+				}
+				else {
+					same->calls += counter.calls;
+					same->cycles += counter.cycles;
+					same->bytes += counter.bytes;
+				}
+			}
+
+			return counters;
+		}
+	}
+#else
+	template <instrumentation::Operation Operation, typename T, typename Field = void>
+	struct _internal_Probe {
+		constexpr _internal_Probe() = default;
+
+		template <typename IO>
+		constexpr explicit _internal_Probe(IO const&) {}
+	};
+
+	namespace instrumentation {
+		inline std::vector<Counter> snapshot() {
+			return {};
+		}
+	}
+#endif
+}
+
+namespace reflection {
+	// class that has access to reflected private data members
+	struct query {
+		template <typename T>
+		constexpr static bool reflectable() {
+			return requires {
+				std::remove_cvref_t<T>::_reflection_fields_n;
+			};
+		}
+
+		template <typename T>
+		constexpr static auto getNumberOfFields() {
+			return std::remove_cvref_t<T>::_reflection_fields_n;
+		}
+
+		// Get a specific FieldData of object type T, index N.
+		template<int N, typename T>
+		constexpr static auto getFieldData(T&& object) {
+			return typename std::remove_cvref_t<T>::template FieldData<N, T>(std::forward<T>(object));
+		}
+
+		// Type of a specific FieldData of object type T, index N. Used when there is no object to work with.
+		template<int N, typename T>
+		using FieldDataType = typename std::remove_cvref_t<T>::template FieldData<N, T>;
+	};
+
+	template <typename T>
+	constexpr bool isReflectable() {
+		return query::reflectable<T>();
+	}
+
+	template <typename T>
+	constexpr auto getNumberOfFields() {
+		return query::getNumberOfFields<T>();
+	}
+
+	template <typename T, typename Functor, std::size_t... ints>
+	constexpr void forEach(T&& x, Functor callback, std::integer_sequence<std::size_t, ints...>) {
+		(callback(query::getFieldData<ints>(std::forward<T>(x))), ...);	// Using the comma operator fold expression to invoke callback function for each field data.
+	}
+
+	template<typename T, typename Functor>
+	constexpr void iterateThroughMember(T&& x, Functor func) {
+		forEach(std::forward<T>(x), func, std::make_integer_sequence<std::size_t, query::getNumberOfFields<T>()>());
+	}
+
+	template <typename T, std::size_t N>
+	struct Field {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+		static_assert(N < static_cast<std::size_t>(getNumberOfFields<T>()), "Data member index out of range.");
+
+		using type = typename query::FieldDataType<N, T>::type;
+
+		static constexpr std::size_t index = N;
+
+		static constexpr std::string_view name() {
+			return query::FieldDataType<N, T>::name();
+		}
+
+		static constexpr auto pointer() {
+			return query::FieldDataType<N, T>::getPointerToMember();
+		}
+
+		static constexpr std::size_t offset() {
+			return query::FieldDataType<N, T>::offset();
+		}
+
+		static constexpr FieldAttributes attributes() {
+			return query::FieldDataType<N, T>::attributes();
+		}
+
+		template <typename Object>
+			requires std::same_as<std::remove_cvref_t<Object>, T>
+		static constexpr decltype(auto) get(Object&& x) {
+			return (static_cast<Object&&>(x).*pointer());
+		}
+	};
+
+	template <typename T, typename Functor>
+	constexpr void forEachField(Functor&& func) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		using Type = std::remove_cvref_t<T>;
+
+		[&]<std::size_t... ints>(std::index_sequence<ints...>) {
+			(func(Field<Type, ints> {}), ...);
+		}(std::make_index_sequence<getNumberOfFields<Type>()>());
+	}
+
+	template<typename Functor, typename Functor2, typename Functor3, typename T>
+	constexpr void _internal_visit(Functor&& func, Functor2&& enterFunc, Functor3&& exitFunc, T&& x);
+
+	template<typename Functor, typename T>
+	constexpr void visit(Functor&& func, T&& x) {
+		visit(std::forward<Functor>(func), []{}, []{}, std::forward<T>(x));
+	}
+
+	template<typename Functor, typename Functor2, typename Functor3, typename T>
+	constexpr void visit(Functor&& func, Functor2&& enterFunc, Functor3&& exitFunc, T&& x) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		[[maybe_unused]] _internal_Probe<instrumentation::Operation::visit, std::remove_cvref_t<T>> probe;
+
+		iterateThroughMember(std::forward<T>(x), [&]<typename U>(U&& fieldData) {
+			[[maybe_unused]] _internal_Probe<instrumentation::Operation::visit, std::remove_cvref_t<T>, std::remove_cvref_t<U>> fieldProbe;
+
+			if constexpr (isReflectable<typename std::remove_cvref_t<U>::type>()) {
+				_internal_visit(std::forward<Functor>(func), std::forward<Functor2>(enterFunc), std::forward<Functor3>(exitFunc), std::forward<U>(fieldData).get());
+			}
+			else {
+				func(std::forward<U>(fieldData));
+			}
+		});
+	}
+
+	template<typename Functor, typename Functor2, typename Functor3, typename T>
+	constexpr void _internal_visit(Functor&& func, Functor2&& enterFunc, Functor3&& exitFunc, T&& x) {
+		[[maybe_unused]] _internal_Probe<instrumentation::Operation::visit, std::remove_cvref_t<T>> probe;
+
+		enterFunc();
+
+		iterateThroughMember(std::forward<T>(x), [&]<typename U>(U && fieldData) {
+			[[maybe_unused]] _internal_Probe<instrumentation::Operation::visit, std::remove_cvref_t<T>, std::remove_cvref_t<U>> fieldProbe;
+
+			if constexpr (isReflectable<typename std::remove_cvref_t<U>::type>()) {
+				_internal_visit(std::forward<Functor>(func), std::forward<Functor2>(enterFunc), std::forward<Functor3>(exitFunc), std::forward<U>(fieldData).get());
+			}
+			else {
+				func(std::forward<U>(fieldData));
+			}
+		});
+
+		exitFunc();
+	}
+}
+
+/*!========================================================================
+	Leaves of an object. A leaf is a non reflectable data member reached by
+	recursing through reflectable data members, in visit order.
+========================================================================*/
+namespace reflection {
+	struct LeafData {
+		std::size_t offset;		// from the start of the outermost object.
+		std::size_t size;
+		bool trivial;			// trivially copyable and without encoding attributes, serialized with memcpy.
+		bool bitwise;			// scalars with unique object representations, equal values have equal bytes so they can be compared with memcmp.
+		FieldAttributes attributes;
+	};
+
+	template <typename T>
+	constexpr std::size_t getNumberOfLeaves() {
+		using Type = std::remove_cvref_t<T>;
+
+		if constexpr (isReflectable<Type>()) {
+			return []<std::size_t... ints>(std::index_sequence<ints...>) {
+				return (std::size_t{ 0 } + ... + getNumberOfLeaves<typename query::FieldDataType<ints, Type>::type>());
+			}(std::make_index_sequence<getNumberOfFields<Type>()>());
+		}
+		else {
+			return 1;
+		}
+	}
+
+	// Number of leaves belonging to the data members before data member N.
+	template <typename T, std::size_t N>
+	constexpr std::size_t _internal_leavesBefore() {
+		return []<std::size_t... ints>(std::index_sequence<ints...>) {
+			return (std::size_t{ 0 } + ... + getNumberOfLeaves<typename query::FieldDataType<ints, T>::type>());
+		}(std::make_index_sequence<N>());
+	}
+
+	template <typename T, std::size_t Size>
+	constexpr void _internal_collectLeaves(std::array<LeafData, Size>& leaves, std::size_t& count, std::size_t offset, FieldAttributes attributes = {}) {
+		if constexpr (isReflectable<T>()) {
+			// data members without attributes of their own inherit the ones of the reflectable data member holding them.
+			auto inherit = [&](FieldAttributes own) { return own.encoded() ? own : attributes; };
+
+			[&]<std::size_t... ints>(std::index_sequence<ints...>) {
+				(_internal_collectLeaves<typename query::FieldDataType<ints, T>::type>(leaves, count, offset + query::FieldDataType<ints, T>::offset(), inherit(query::FieldDataType<ints, T>::attributes())), ...);
+			}(std::make_index_sequence<getNumberOfFields<T>()>());
+		}
+		else {
+			leaves[count++] = {
+				offset,
+				sizeof(T),
+				std::is_trivially_copyable_v<T> && !attributes.encoded(),
+				std::has_unique_object_representations_v<T> && std::is_scalar_v<std::remove_all_extents_t<T>>,
+				attributes
+			};
+		}
+	}
+
+	template <typename T>
+	constexpr auto getLeaves() {
+		std::array<LeafData, getNumberOfLeaves<T>()> leaves {};
+		std::size_t count = 0;
+		_internal_collectLeaves<std::remove_cvref_t<T>>(leaves, count, 0);
+		return leaves;
+	}
+
+	// First leaf of every data member of T, followed by the number of leaves.
+	template <typename T>
+	inline constexpr auto _internal_leafStarts = []<std::size_t... ints>(std::index_sequence<ints...>) {
+		std::array<std::size_t, sizeof...(ints) + 1> starts { _internal_leavesBefore<T, ints>()..., getNumberOfLeaves<T>() };
+		return starts;
+	}(std::make_index_sequence<getNumberOfFields<T>()>());
+
+	// Index of the data member of T holding every leaf.
+	template <typename T>
+	inline constexpr auto _internal_leafFields = [] {
+		std::array<std::size_t, getNumberOfLeaves<T>()> fields {};
+
+		for (std::size_t field = 0, leaf = 0; leaf < fields.size(); ++leaf) {
+			while (_internal_leafStarts<T>[field + 1] <= leaf) {
+				++field;
+			}
+
+			fields[leaf] = field;
+		}
+
+		return fields;
+	}();
+
+	/*!***********************************************************************
+	* @brief
+	*	Reference to leaf Leaf of x, reached through the chain of pointers to
+	*	data members leading to it. Objects of the same type share the chain,
+	*	so every (type, leaf) pair is instantiated only once.
+	**************************************************************************/
+	template <std::size_t Leaf, typename T>
+	constexpr decltype(auto) _internal_leafAt(T&& x) {
+		using Type = std::remove_cvref_t<T>;
+
+		if constexpr (isReflectable<Type>()) {
+			constexpr std::size_t field = _internal_leafFields<Type>[Leaf];
+			return _internal_leafAt<Leaf - _internal_leafStarts<Type>[field]>(std::forward<T>(x).*query::FieldDataType<field, Type>::getPointerToMember());
+		}
+		else {
+			return std::forward<T>(x);
+		}
+	}
+
+	// Invokes func(std::integral_constant<std::size_t, leafIndex>{}, leaf) for every leaf of x, in a single fold.
+	template <typename T, typename Functor>
+	constexpr void _internal_visitLeaves(T&& x, Functor&& func) {
+		[&]<std::size_t... leaves>(std::index_sequence<leaves...>) {
+			(func(std::integral_constant<std::size_t, leaves>{}, _internal_leafAt<leaves>(x)), ...);
+		}(std::make_index_sequence<getNumberOfLeaves<T>()>());
+	}
+
+	// Invokes func(std::integral_constant<std::size_t, leafIndex>{}, leafOfA, leafOfB) for every leaf until it returns false.
+	template <typename T, typename Functor>
+	constexpr bool _internal_allLeafPairs(T const& a, T const& b, Functor&& func) {
+		return [&]<std::size_t... leaves>(std::index_sequence<leaves...>) {
+			return (... && func(std::integral_constant<std::size_t, leaves>{}, _internal_leafAt<leaves>(a), _internal_leafAt<leaves>(b)));
+		}(std::make_index_sequence<getNumberOfLeaves<T>()>());
+	}
+
+	// For every leaf starting a run of contiguous leaves with Flag set, the size of the run in bytes. 0 for every other leaf.
+	template <typename T, bool LeafData::* Flag = &LeafData::trivial>
+	constexpr auto _internal_getRunSizes() {
+		constexpr auto leaves = getLeaves<T>();
+		std::array<std::size_t, leaves.size()> runSizes {};
+
+		auto continuesRun = [&](std::size_t i) {
+			return i > 0 && leaves[i].*Flag && leaves[i - 1].*Flag && leaves[i - 1].offset + leaves[i - 1].size == leaves[i].offset;
+		};
+
+		for (std::size_t i = 0; i < leaves.size(); ++i) {
+			if (!(leaves[i].*Flag) || continuesRun(i)) {
+				continue;
+			}
+
+			runSizes[i] = leaves[i].size;
+
+			for (std::size_t j = i + 1; j < leaves.size() && continuesRun(j); ++j) {
+				runSizes[i] += leaves[j].size;
+			}
+		}
+
+		return runSizes;
+	}
+
+	template <typename T>
+	inline constexpr auto _internal_leaves = getLeaves<T>();
+
+	template <typename T>
+	inline constexpr auto _internal_runSizes = _internal_getRunSizes<T>();
+
+	// Runs of leaves that can be compared and hashed as bytes.
+	template <typename T>
+	inline constexpr auto _internal_bitwiseRunSizes = _internal_getRunSizes<T, &LeafData::bitwise>();
+
+	// Position of every leaf in the serialized form, only meaningful when every leaf is trivially copyable.
+	template <typename T>
+	inline constexpr auto _internal_packedOffsets = [] {
+		std::array<std::size_t, _internal_leaves<T>.size()> offsets {};
+		std::size_t offset = 0;
+
+		for (std::size_t i = 0; i < offsets.size(); ++i) {
+			offsets[i] = offset;
+			offset += _internal_leaves<T>[i].size;
+		}
+
+		return offsets;
+	}();
+
+	template <typename T>
+	constexpr bool _internal_isFixedSize() {
+		for (LeafData const& leaf : _internal_leaves<T>) {
+			if (!leaf.trivial) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template <typename T>
+	constexpr bool _internal_hasEncodedLeaves() {
+		for (LeafData const& leaf : _internal_leaves<T>) {
+			if (leaf.attributes.encoded()) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	template <typename T>
+	constexpr std::size_t _internal_packedSize() {
+		std::size_t size = 0;
+
+		for (LeafData const& leaf : _internal_leaves<T>) {
+			size += leaf.size;
+		}
+
+		return size;
+	}
+
+	template <typename... Ts>
+	struct TypeList {
+		static constexpr std::size_t size = sizeof...(Ts);
+	};
+
+	template <std::size_t N, typename List>
+	struct _internal_typeAt;
+
+	template <std::size_t N, typename First, typename... Rest>
+	struct _internal_typeAt<N, TypeList<First, Rest...>> : _internal_typeAt<N - 1, TypeList<Rest...>> {};
+
+	template <typename First, typename... Rest>
+	struct _internal_typeAt<0, TypeList<First, Rest...>> { using type = First; };
+
+	// N-th type of a TypeList.
+	template <std::size_t N, typename List>
+	using TypeAt = typename _internal_typeAt<N, List>::type;
+
+	template <typename... Lists>
+	struct _internal_concat { using type = TypeList<>; };
+
+	template <typename... Ts>
+	struct _internal_concat<TypeList<Ts...>> { using type = TypeList<Ts...>; };
+
+	template <typename... Ts, typename... Us, typename... Lists>
+	struct _internal_concat<TypeList<Ts...>, TypeList<Us...>, Lists...> : _internal_concat<TypeList<Ts..., Us...>, Lists...> {};
+
+	template <typename T, bool = isReflectable<T>()>
+	struct _internal_leafTypes { using type = TypeList<T>; };
+
+	template <typename T>
+	struct _internal_leafTypes<T, true> {
+		using type = decltype([]<std::size_t... ints>(std::index_sequence<ints...>) {
+			return typename _internal_concat<typename _internal_leafTypes<typename query::FieldDataType<ints, T>::type>::type...>::type {};
+		}(std::make_index_sequence<getNumberOfFields<T>()>()));
+	};
+
+	// Types of every leaf of T, in visit order.
+	template <typename T>
+	using LeafTypes = typename _internal_leafTypes<std::remove_cvref_t<T>>::type;
+
+	template <typename T>
+	struct _internal_fieldTypes {
+		using type = decltype([]<std::size_t... ints>(std::index_sequence<ints...>) {
+			return TypeList<typename query::FieldDataType<ints, T>::type...> {};
+		}(std::make_index_sequence<getNumberOfFields<T>()>()));
+	};
+
+	// Types of the reflected data members of T, in the order given to REFLECTABLE. Reflectable data members are not flattened.
+	template <typename T>
+	using FieldTypes = typename _internal_fieldTypes<std::remove_cvref_t<T>>::type;
+
+	// Leaves are named by the path of data member names leading to them, points1.pt2.x
+	template <typename T>
+	constexpr std::size_t _internal_leafNamesLength() {
+		if constexpr (isReflectable<T>()) {
+			return []<std::size_t... ints>(std::index_sequence<ints...>) {
+				return (std::size_t{ 0 } + ... + (
+					isReflectable<typename query::FieldDataType<ints, T>::type>()
+						? getNumberOfLeaves<typename query::FieldDataType<ints, T>::type>() * (std::string_view{ query::FieldDataType<ints, T>::name() }.size() + 1) + _internal_leafNamesLength<typename query::FieldDataType<ints, T>::type>()
+						: std::string_view{ query::FieldDataType<ints, T>::name() }.size()
+				));
+			}(std::make_index_sequence<getNumberOfFields<T>()>());
+		}
+		else {
+			return 0;
+		}
+	}
+
+	template <typename T, typename Storage>
+	constexpr void _internal_collectLeafNames(Storage& storage, std::size_t& length, std::size_t& count, std::string const& prefix) {
+		[&]<std::size_t... ints>(std::index_sequence<ints...>) {
+			([&] {
+				using Field = query::FieldDataType<ints, T>;
+				std::string const path = prefix + Field::name();
+
+				if constexpr (isReflectable<typename Field::type>()) {
+					_internal_collectLeafNames<typename Field::type>(storage, length, count, path + '.');
+				}
+				else {
+					std::copy(path.begin(), path.end(), storage.characters.begin() + length);
+					storage.names[count++] = { length, path.size() };
+					length += path.size();
+				}
+			}(), ...);
+		}(std::make_index_sequence<getNumberOfFields<T>()>());
+	}
+
+	template <typename T>
+	struct _internal_LeafNameStorage {
+		std::array<char, _internal_leafNamesLength<T>()> characters {};
+		std::array<std::pair<std::size_t, std::size_t>, getNumberOfLeaves<T>()> names {};	// position and length in characters.
+	};
+
+	template <typename T>
+	inline constexpr auto _internal_leafNameStorage = [] {
+		_internal_LeafNameStorage<T> storage {};
+		std::size_t length = 0;
+		std::size_t count = 0;
+		_internal_collectLeafNames<T>(storage, length, count, "");
+		return storage;
+	}();
+
+	template <typename T>
+	inline constexpr auto _internal_leafNames = [] {
+		std::array<std::string_view, getNumberOfLeaves<T>()> names {};
+
+		for (std::size_t i = 0; i < names.size(); ++i) {
+			auto const [position, length] = _internal_leafNameStorage<T>.names[i];
+			names[i] = std::string_view{ _internal_leafNameStorage<T>.characters.data() + position, length };
+		}
+
+		return names;
+	}();
+
+	template <typename T>
+	constexpr std::size_t _internal_leafIndex(std::string_view name) {
+		for (std::size_t i = 0; i < _internal_leafNames<T>.size(); ++i) {
+			if (_internal_leafNames<T>[i] == name) {
+				return i;
+			}
+		}
+
+		return _internal_leafNames<T>.size();
+	}
+}
+
+/*!========================================================================
+	Compile time type information and layout
+========================================================================*/
+namespace reflection {
+	template <typename T>
+	constexpr std::string_view _internal_functionSignature() {
+#if defined(_MSC_VER) && !defined(__clang__)
+		return __FUNCSIG__;
+#else
+		return __PRETTY_FUNCTION__;
+#endif
+	}
+
+	template <typename T>
+	constexpr std::string_view typeName() {
+		// the signature of a probe type tells us how much surrounds the type name.
+		constexpr std::string_view probe = _internal_functionSignature<double>();
+		constexpr std::size_t prefix = probe.find("double");
+		constexpr std::size_t suffix = probe.size() - prefix - std::string_view{ "double" }.size();
+
+		std::string_view const signature = _internal_functionSignature<T>();
+		return signature.substr(prefix, signature.size() - prefix - suffix);
+	}
+
+	constexpr std::uint64_t _internal_fnv1a(std::string_view string, std::uint64_t hash = 0xcbf29ce484222325ull) {
+		for (char character : string) {
+			hash = (hash ^ static_cast<unsigned char>(character)) * 0x100000001b3ull;
+		}
+
+		return hash;
+	}
+
+	template <typename T>
+	constexpr std::uint64_t typeId() {
+		return _internal_fnv1a(typeName<T>());
+	}
+
+	template <typename T>
+	constexpr std::array<FieldLayout, getNumberOfFields<T>()> layout() {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		using Type = std::remove_cvref_t<T>;
+
+		return []<std::size_t... ints>(std::index_sequence<ints...>) {
+			return std::array<FieldLayout, getNumberOfFields<T>()> {
+				FieldLayout {
+					query::FieldDataType<ints, Type>::name(),
+					query::FieldDataType<ints, Type>::offset(),
+					sizeof(typename query::FieldDataType<ints, Type>::type),
+					alignof(typename query::FieldDataType<ints, Type>::type),
+					typeId<typename query::FieldDataType<ints, Type>::type>()
+				}...
+			};
+		}(std::make_index_sequence<getNumberOfFields<T>()>());
+	}
+}
+
+/*!========================================================================
+	Perfect hash lookup of data members by name
+========================================================================*/
+namespace reflection {
+	// Mixes the name hash with the displacement of its bucket, so lookups only hash the name once.
+	constexpr std::uint64_t _internal_mix(std::uint64_t hash, std::uint64_t seed) {
+		hash ^= seed * 0x9e3779b97f4a7c15ull;
+		hash ^= hash >> 33;
+		hash *= 0xff51afd7ed558ccdull;
+		hash ^= hash >> 33;
+		return hash;
+	}
+
+	/*!***********************************************************************
+	* @brief
+	*	Hash and displace perfect hash table. Names are hashed once and split into
+	*	buckets. For every bucket, largest first, a seed is searched for that moves
+	*	all of its names into free slots of the table.
+	**************************************************************************/
+	template <std::size_t FieldCount>
+	struct _internal_PerfectHashTable {
+		static constexpr std::size_t bucketCount = std::bit_ceil(FieldCount);
+		static constexpr std::size_t slotCount = 2 * bucketCount;
+		static constexpr std::uint16_t empty = 0xFFFF;
+
+		std::array<std::uint32_t, bucketCount> seeds {};
+		std::array<std::uint16_t, slotCount> slots {};
+
+		constexpr std::size_t slot(std::uint64_t hash) const {
+			return _internal_mix(hash, seeds[hash & (bucketCount - 1)]) & (slotCount - 1);
+		}
+	};
+
+	template <typename T>
+	constexpr auto _internal_buildPerfectHashTable() {
+		constexpr auto fields = layout<T>();
+		constexpr std::size_t count = fields.size();
+
+		_internal_PerfectHashTable<count> table {};
+		using Table = decltype(table);
+
+		std::array<std::uint64_t, count> hashes {};
+		std::array<std::size_t, Table::bucketCount> bucketSizes {};
+
+		for (std::size_t i = 0; i < count; ++i) {
+			hashes[i] = _internal_fnv1a(fields[i].name);
+			++bucketSizes[hashes[i] & (Table::bucketCount - 1)];
+		}
+
+		// place larger buckets first, while the table still has plenty of room.
+		std::array<std::size_t, Table::bucketCount> order {};
+		for (std::size_t i = 0; i < order.size(); ++i) {
+			order[i] = i;
+		}
+		std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return bucketSizes[a] > bucketSizes[b]; });
+
+		table.slots.fill(Table::empty);
+
+		for (std::size_t bucket : order) {
+			if (bucketSizes[bucket] == 0) {
+				break;
+			}
+
+			for (std::uint32_t seed = 0;; ++seed) {
+				table.seeds[bucket] = seed;
+
+				std::array<std::size_t, count> taken {};
+				std::size_t takenCount = 0;
+				bool fits = true;
+
+				for (std::size_t i = 0; i < count && fits; ++i) {
+					if ((hashes[i] & (Table::bucketCount - 1)) != bucket) {
+						continue;
+					}
+
+					std::size_t const slot = table.slot(hashes[i]);
+					fits = table.slots[slot] == Table::empty && std::find(taken.begin(), taken.begin() + takenCount, slot) == taken.begin() + takenCount;
+					taken[takenCount++] = slot;
+				}
+
+				if (fits) {
+					for (std::size_t i = 0; i < count; ++i) {
+						if ((hashes[i] & (Table::bucketCount - 1)) == bucket) {
+							table.slots[table.slot(hashes[i])] = static_cast<std::uint16_t>(i);
+						}
+					}
+
+					break;
+				}
+			}
+		}
+
+		return table;
+	}
+
+	template <typename T>
+	inline constexpr auto _internal_perfectHashTable = _internal_buildPerfectHashTable<std::remove_cvref_t<T>>();
+
+	template <typename T>
+	constexpr std::size_t indexOf(std::string_view name) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		constexpr auto fields = layout<T>();
+		auto const& table = _internal_perfectHashTable<T>;
+
+		std::uint16_t const index = table.slots[table.slot(_internal_fnv1a(name))];
+		return index != table.empty && fields[index].name == name ? index : fields.size();
+	}
+
+	template <typename T>
+	std::size_t findField(std::string_view name) {
+		return indexOf<T>(name);
+	}
+
+	template<typename Functor, typename T>
+	bool visitField(std::string_view name, Functor&& func, T&& x) {
+		using Object = std::remove_reference_t<T>;
+		using Thunk = void(*)(Functor&, Object&);
+
+		std::size_t const index = findField<T>(name);
+
+		if (index == getNumberOfFields<T>()) {
+			return false;
+		}
+
+		// jump table with one entry per data member.
+		static constexpr auto thunks = []<std::size_t... ints>(std::index_sequence<ints...>) {
+			return std::array<Thunk, sizeof...(ints)> {
+				[](Functor& func, Object& object) { func(query::getFieldData<ints>(static_cast<T&&>(object))); }...
+			};
+		}(std::make_index_sequence<getNumberOfFields<T>()>());
+
+		thunks[index](func, x);
+		return true;
+	}
+}
+
+/*!========================================================================
+	Binary serialization
+========================================================================*/
+namespace reflection {
+	template <typename T>
+	concept _internal_pairLike = requires { typename T::first_type; typename T::second_type; };
+
+	// std::map's value_type has a const key, which cannot be deserialized into.
+	template <typename T>
+	struct _internal_mutable { using type = T; };
+
+	template <typename K, typename V>
+	struct _internal_mutable<std::pair<K const, V>> { using type = std::pair<K, V>; };
+
+	template <ByteBuffer Buffer>
+	struct _internal_BinaryWriter {
+		Buffer& buffer;
+
+		std::byte* reserve(std::size_t size) {
+			std::size_t const oldSize = buffer.size();
+			buffer.resize(oldSize + size);
+			return reinterpret_cast<std::byte*>(buffer.data()) + oldSize;
+		}
+
+		void write(void const* source, std::size_t size) {
+			if (size) {
+				std::memcpy(reserve(size), source, size);
+			}
+		}
+
+		std::uint64_t processed() const {
+			return buffer.size();
+		}
+	};
+
+	struct _internal_BinaryReader {
+		std::span<const std::byte> bytes;
+		std::size_t position = 0;
+		bool failed = false;
+		std::pmr::memory_resource* resource = nullptr;	// for data members with polymorphic allocators, if set.
+
+		std::size_t remaining() const {
+			return bytes.size() - position;
+		}
+
+		// Most bytes containers may allocate for before reading them, every byte is already there.
+		std::size_t allocationLimit() const {
+			return remaining();
+		}
+
+		std::uint64_t processed() const {
+			return position;
+		}
+
+		// Returns a pointer to the next size bytes and advances past them, or nullptr if there aren't enough bytes left.
+		std::byte const* consume(std::size_t size) {
+			if (failed || remaining() < size) {
+				failed = true;
+				return nullptr;
+			}
+
+			std::byte const* data = bytes.data() + position;
+			position += size;
+			return data;
+		}
+
+		bool read(void* destination, std::size_t size) {
+			std::byte const* source = consume(size);
+
+			if (source && size) {
+				std::memcpy(destination, source, size);
+			}
+
+			return source;
+		}
+	};
+
+	template <typename Writer, typename T>
+	void _internal_serializeObject(Writer& writer, T const& x);
+
+	template <typename Reader, typename T>
+	void _internal_deserializeObject(Reader& reader, T& x);
+
+	template <typename Writer, typename T>
+	void _internal_serializeValue(Writer& writer, T const& value) {
+		if constexpr (isReflectable<T>()) {
+			_internal_serializeObject(writer, value);
+		}
+		else if constexpr (std::is_trivially_copyable_v<T>) {
+			writer.write(std::addressof(value), sizeof(T));
+		}
+		else if constexpr (_internal_pairLike<T>) {
+			_internal_serializeValue(writer, value.first);
+			_internal_serializeValue(writer, value.second);
+		}
+		else if constexpr (std::ranges::sized_range<T const>) {
+			using Element = std::ranges::range_value_t<T const>;
+
+			std::uint64_t const count = std::ranges::size(value);
+			writer.write(&count, sizeof(count));
+
+			if constexpr (std::ranges::contiguous_range<T const> && std::is_trivially_copyable_v<Element> && !isReflectable<Element>()) {
+				writer.write(std::ranges::data(value), count * sizeof(Element));
+			}
+			else {
+				for (auto const& element : value) {
+					_internal_serializeValue(writer, element);
+				}
+			}
+		}
+		else {
+			static_assert(sizeof(T) == 0, "Data member is not serializable! It must be reflectable, trivially copyable, a pair or a sized range.");
+		}
+	}
+
+	template <typename T>
+	concept _internal_polymorphicAllocated = requires { typename T::allocator_type; }
+		&& std::same_as<typename T::allocator_type, std::pmr::polymorphic_allocator<typename T::allocator_type::value_type>>;
+
+	// Element constructed with the allocator of container, so moving it in doesn't allocate again.
+	template <typename Element, typename Container>
+	Element _internal_makeElement(Container const& container) {
+		if constexpr (requires { container.get_allocator(); } && std::uses_allocator_v<Element, typename Container::allocator_type>) {
+			return std::make_obj_using_allocator<Element>(container.get_allocator());
+		}
+		else {
+			return Element {};
+		}
+	}
+
+	template <typename Reader, typename T>
+	void _internal_deserializeValue(Reader& reader, T& value) {
+		if constexpr (_internal_polymorphicAllocated<T>) {
+			// polymorphic allocators don't propagate on assignment, so the data member is recreated on the resource.
+			if (reader.resource && value.get_allocator().resource() != reader.resource) {
+				std::destroy_at(std::addressof(value));
+				std::construct_at(std::addressof(value), typename T::allocator_type{ reader.resource });
+			}
+		}
+
+		if constexpr (isReflectable<T>()) {
+			_internal_deserializeObject(reader, value);
+		}
+		else if constexpr (std::is_trivially_copyable_v<T>) {
+			reader.read(std::addressof(value), sizeof(T));
+		}
+		else if constexpr (_internal_pairLike<T>) {
+			_internal_deserializeValue(reader, value.first);
+			_internal_deserializeValue(reader, value.second);
+		}
+		else if constexpr (std::ranges::sized_range<T>) {
+			using Element = typename _internal_mutable<std::ranges::range_value_t<T>>::type;
+
+			std::uint64_t count = 0;
+
+			// every element takes at least a byte, this rejects malformed counts before allocating.
+			if (!reader.read(&count, sizeof(count)) || count > reader.remaining()) {
+				reader.failed = true;
+				return;
+			}
+
+			if constexpr (std::ranges::contiguous_range<T> && std::is_trivially_copyable_v<Element> && !isReflectable<Element>() && requires { value.resize(count); }) {
+				if (count > reader.remaining() / sizeof(Element)) {
+					reader.failed = true;
+					return;
+				}
+
+				// count can't be trusted with a single allocation when the bytes are still on their way, so the data member grows as they arrive.
+				std::size_t const step = std::max<std::size_t>(reader.allocationLimit() / sizeof(Element), 1);
+				value.resize(std::min<std::size_t>(std::ranges::size(value), static_cast<std::size_t>(count)));
+
+				for (std::size_t size = 0; size < count && !reader.failed;) {
+					std::size_t const next = size + static_cast<std::size_t>(std::min<std::uint64_t>(count - size, step));
+
+					if (std::ranges::size(value) < next) {
+						value.resize(next);
+					}
+
+					reader.read(std::ranges::data(value) + size, (next - size) * sizeof(Element));
+					size = next;
+				}
+			}
+			else if constexpr (requires (Element element) { value.clear(); value.push_back(std::move(element)); } || requires (Element element) { value.clear(); value.insert(std::move(element)); }) {
+				value.clear();
+
+				if constexpr (requires { value.reserve(count); }) {
+					// allocationLimit is in bytes, every element takes at least sizeof(Element) of them once constructed.
+					value.reserve(static_cast<std::size_t>(std::min<std::uint64_t>(count, std::max<std::size_t>(reader.allocationLimit() / sizeof(Element), 1))));
+				}
+
+				for (std::uint64_t i = 0; i < count && !reader.failed; ++i) {
+					Element element = _internal_makeElement<Element>(value);
+					_internal_deserializeValue(reader, element);
+
+					if constexpr (requires { value.push_back(std::move(element)); }) {
+						value.push_back(std::move(element));
+					}
+					else {
+						value.insert(std::move(element));
+					}
+				}
+			}
+			else {
+				// fixed size ranges, like std::array of non trivially copyable elements.
+				if (count != std::ranges::size(value)) {
+					reader.failed = true;
+					return;
+				}
+
+				for (auto& element : value) {
+					_internal_deserializeValue(reader, element);
+				}
+			}
+		}
+		else {
+			static_assert(sizeof(T) == 0, "Data member is not deserializable! It must be reflectable, trivially copyable, a pair or a sized range.");
+		}
+	}
+
+	template <typename T>
+	using _internal_integerOf = typename std::conditional_t<std::is_enum_v<T>, std::underlying_type<T>, std::type_identity<T>>::type;
+
+	template <std::size_t Bytes, bool Signed>
+	using _internal_fixedWidthInteger = std::conditional_t<Bytes == 1, std::conditional_t<Signed, std::int8_t, std::uint8_t>,
+		std::conditional_t<Bytes == 2, std::conditional_t<Signed, std::int16_t, std::uint16_t>,
+		std::conditional_t<Bytes == 4, std::conditional_t<Signed, std::int32_t, std::uint32_t>, std::conditional_t<Signed, std::int64_t, std::uint64_t>>>>;
+
+	// Serializes leaf I of T with the encoding its attributes ask for.
+	template <typename T, std::size_t I, typename Writer, typename U>
+	void _internal_serializeLeaf(Writer& writer, U const& leaf) {
+		constexpr FieldAttributes attributes = _internal_leaves<T>[I].attributes;
+
+		if constexpr (attributes.skip) {
+			return;
+		}
+		else if constexpr (attributes.varint) {
+			static_assert(std::is_integral_v<U> || std::is_enum_v<U>, "varint data member must be an integer or an enum.");
+
+			using Integer = _internal_integerOf<U>;
+			using Unsigned = std::make_unsigned_t<Integer>;
+
+			Integer const value = static_cast<Integer>(leaf);
+			Unsigned encoded = static_cast<Unsigned>(value);
+
+			if constexpr (std::is_signed_v<Integer>) {
+				encoded = static_cast<Unsigned>(static_cast<Unsigned>(encoded << 1) ^ static_cast<Unsigned>(value >> (sizeof(Integer) * 8 - 1)));
+			}
+
+			std::byte bytes[(sizeof(Unsigned) * 8 + 6) / 7];
+			std::size_t count = 0;
+
+			do {
+				std::uint8_t const low = static_cast<std::uint8_t>(encoded & 0x7f);
+				encoded = static_cast<Unsigned>(encoded >> 7);
+				bytes[count++] = static_cast<std::byte>(encoded ? low | 0x80 : low);
+			} while (encoded);
+
+			writer.write(bytes, count);
+		}
+		else if constexpr (attributes.fixedWidth != 0) {
+			static_assert(std::is_integral_v<U> || std::is_enum_v<U>, "fixedWidth data member must be an integer or an enum.");
+
+			using Narrow = _internal_fixedWidthInteger<attributes.fixedWidth, std::is_signed_v<_internal_integerOf<U>>>;
+
+			Narrow const value = static_cast<Narrow>(static_cast<_internal_integerOf<U>>(leaf));
+			writer.write(&value, sizeof(value));
+		}
+		else if constexpr (attributes.quantized) {
+			static_assert(std::is_floating_point_v<U>, "quantize data member must be floating point.");
+			static_assert(attributes.minimum < attributes.maximum, "quantize needs minimum < maximum.");
+
+			double const value = static_cast<double>(leaf);
+			double const clamped = value < attributes.minimum || value != value ? attributes.minimum : std::min(value, attributes.maximum);
+			std::uint16_t const quantized = static_cast<std::uint16_t>((clamped - attributes.minimum) / (attributes.maximum - attributes.minimum) * 65535.0 + 0.5);
+
+			writer.write(&quantized, sizeof(quantized));
+		}
+		else {
+			_internal_serializeValue(writer, leaf);
+		}
+	}
+
+	template <typename T, std::size_t I, typename Reader, typename U>
+	void _internal_deserializeLeaf(Reader& reader, U& leaf) {
+		constexpr FieldAttributes attributes = _internal_leaves<T>[I].attributes;
+
+		if constexpr (attributes.skip) {
+			return;
+		}
+		else if constexpr (attributes.varint) {
+			using Integer = _internal_integerOf<U>;
+			using Unsigned = std::make_unsigned_t<Integer>;
+
+			Unsigned encoded = 0;
+
+			for (std::size_t shift = 0;; shift += 7) {
+				std::byte const* byte = shift < sizeof(Unsigned) * 8 ? reader.consume(1) : nullptr;
+
+				if (!byte) {
+					reader.failed = true;
+					return;
+				}
+
+				std::uint8_t const bits = std::to_integer<std::uint8_t>(*byte);
+				encoded = static_cast<Unsigned>(encoded | static_cast<Unsigned>(static_cast<Unsigned>(bits & 0x7f) << shift));
+
+				if (!(bits & 0x80)) {
+					break;
+				}
+			}
+
+			if constexpr (std::is_signed_v<Integer>) {
+				encoded = static_cast<Unsigned>(static_cast<Unsigned>(encoded >> 1) ^ static_cast<Unsigned>(Unsigned{ 0 } - static_cast<Unsigned>(encoded & 1)));
+			}
+
+			leaf = static_cast<U>(static_cast<Integer>(encoded));
+		}
+		else if constexpr (attributes.fixedWidth != 0) {
+			using Narrow = _internal_fixedWidthInteger<attributes.fixedWidth, std::is_signed_v<_internal_integerOf<U>>>;
+
+			Narrow value {};
+
+			if (reader.read(&value, sizeof(value))) {
+				leaf = static_cast<U>(static_cast<_internal_integerOf<U>>(value));
+			}
+		}
+		else if constexpr (attributes.quantized) {
+			std::uint16_t quantized = 0;
+
+			if (reader.read(&quantized, sizeof(quantized))) {
+				leaf = static_cast<U>(attributes.minimum + quantized * ((attributes.maximum - attributes.minimum) / 65535.0));
+			}
+		}
+		else {
+			_internal_deserializeValue(reader, leaf);
+		}
+	}
+
+	template <typename Writer, typename T>
+	void _internal_serializeObject(Writer& writer, T const& x) {
+		[[maybe_unused]] _internal_Probe<instrumentation::Operation::serialize, T> probe { writer };
+
+		if constexpr (_internal_isFixedSize<T>()) {
+			// size is known at compile time, grow the buffer once.
+			std::byte* destination = writer.reserve(_internal_packedSize<T>());
+
+			_internal_visitLeaves(x, [&]<std::size_t I, typename U>(std::integral_constant<std::size_t, I>, U const& leaf) {
+				if constexpr (_internal_runSizes<T>[I] != 0) {
+					std::memcpy(destination + _internal_packedOffsets<T>[I], std::addressof(leaf), _internal_runSizes<T>[I]);
+				}
+			});
+		}
+		else {
+			_internal_visitLeaves(x, [&]<std::size_t I, typename U>(std::integral_constant<std::size_t, I>, U const& leaf) {
+				if constexpr (!_internal_leaves<T>[I].trivial) {
+					[[maybe_unused]] _internal_Probe<instrumentation::Operation::serialize, T, LeafField<I, T>> leafProbe { writer };
+					_internal_serializeLeaf<T, I>(writer, leaf);
+				}
+				else if constexpr (_internal_runSizes<T>[I] != 0) {
+					writer.write(std::addressof(leaf), _internal_runSizes<T>[I]);
+				}
+			});
+		}
+	}
+
+	template <typename Reader, typename T>
+	void _internal_deserializeObject(Reader& reader, T& x) {
+		[[maybe_unused]] _internal_Probe<instrumentation::Operation::deserialize, T> probe { reader };
+
+		if constexpr (_internal_isFixedSize<T>()) {
+			std::byte const* source = reader.consume(_internal_packedSize<T>());
+
+			if (!source) {
+				return;
+			}
+
+			_internal_visitLeaves(x, [&]<std::size_t I, typename U>(std::integral_constant<std::size_t, I>, U& leaf) {
+				if constexpr (_internal_runSizes<T>[I] != 0) {
+					std::memcpy(std::addressof(leaf), source + _internal_packedOffsets<T>[I], _internal_runSizes<T>[I]);
+				}
+			});
+		}
+		else {
+			_internal_visitLeaves(x, [&]<std::size_t I, typename U>(std::integral_constant<std::size_t, I>, U& leaf) {
+				if constexpr (!_internal_leaves<T>[I].trivial) {
+					[[maybe_unused]] _internal_Probe<instrumentation::Operation::deserialize, T, LeafField<I, T>> leafProbe { reader };
+					_internal_deserializeLeaf<T, I>(reader, leaf);
+				}
+				else if constexpr (_internal_runSizes<T>[I] != 0) {
+					reader.read(std::addressof(leaf), _internal_runSizes<T>[I]);
+				}
+			});
+		}
+	}
+
+	template <typename T, ByteBuffer Buffer>
+	void serialize(T const& x, Buffer& buffer) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		_internal_BinaryWriter<Buffer> writer { buffer };
+		_internal_serializeObject(writer, x);
+	}
+
+	template <typename T>
+	std::size_t deserialize(std::span<const std::byte> bytes, T& x) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		_internal_BinaryReader reader { bytes };
+		_internal_deserializeObject(reader, x);
+
+		return reader.failed ? 0 : reader.position;
+	}
+
+	template <typename T>
+	std::size_t deserialize(std::span<const std::byte> bytes, T& x, std::pmr::memory_resource* resource) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		_internal_BinaryReader reader { bytes, 0, false, resource };
+		_internal_deserializeObject(reader, x);
+
+		return reader.failed ? 0 : reader.position;
+	}
+}
+
+/*!========================================================================
+	Zero copy view over serialized objects
+========================================================================*/
+namespace reflection {
+	template <typename T>
+	constexpr bool _internal_isFixedSizeValue() {
+		if constexpr (isReflectable<T>()) {
+			return _internal_isFixedSize<T>();
+		}
+		else {
+			return std::is_trivially_copyable_v<T>;
+		}
+	}
+
+	template <typename T>
+	constexpr std::size_t _internal_packedSizeOfValue() {
+		if constexpr (isReflectable<T>()) {
+			return _internal_packedSize<T>();
+		}
+		else {
+			return sizeof(T);
+		}
+	}
+
+	// Number of data members of T, starting from the front, that have a fixed size in the serialized form.
+	template <typename T>
+	constexpr std::size_t _internal_fixedSizePrefix() {
+		return []<std::size_t... ints>(std::index_sequence<ints...>) {
+			std::size_t count = 0;
+			((_internal_isFixedSizeValue<typename query::FieldDataType<ints, T>::type>() && count == ints ? ++count : count), ...);
+			return count;
+		}(std::make_index_sequence<getNumberOfFields<T>()>());
+	}
+
+	// Position of data member N in the serialized form, assuming every data member before it has a fixed size.
+	template <typename T, std::size_t N>
+	constexpr std::size_t _internal_packedFieldOffset() {
+		return []<std::size_t... ints>(std::index_sequence<ints...>) {
+			return (std::size_t{ 0 } + ... + _internal_packedSizeOfValue<typename query::FieldDataType<ints, T>::type>());
+		}(std::make_index_sequence<N>());
+	}
+
+	// Advances reader past a value of type T without materializing it.
+	template <typename T>
+	void _internal_skipValue(_internal_BinaryReader& reader) {
+		if constexpr (_internal_isFixedSizeValue<T>()) {
+			reader.consume(_internal_packedSizeOfValue<T>());
+		}
+		else if constexpr (isReflectable<T>()) {
+			[&]<std::size_t... ints>(std::index_sequence<ints...>) {
+				(_internal_skipValue<typename query::FieldDataType<ints, T>::type>(reader), ...);
+			}(std::make_index_sequence<getNumberOfFields<T>()>());
+		}
+		else if constexpr (_internal_pairLike<T>) {
+			_internal_skipValue<std::remove_const_t<typename T::first_type>>(reader);
+			_internal_skipValue<typename T::second_type>(reader);
+		}
+		else {
+			using Element = typename _internal_mutable<std::ranges::range_value_t<T>>::type;
+
+			std::uint64_t count = 0;
+
+			if (!reader.read(&count, sizeof(count)) || count > reader.remaining()) {
+				reader.failed = true;
+				return;
+			}
+
+			if constexpr (_internal_isFixedSizeValue<Element>()) {
+				if (count > reader.remaining() / _internal_packedSizeOfValue<Element>()) {
+					reader.failed = true;
+					return;
+				}
+
+				reader.consume(count * _internal_packedSizeOfValue<Element>());
+			}
+			else {
+				for (std::uint64_t i = 0; i < count && !reader.failed; ++i) {
+					_internal_skipValue<Element>(reader);
+				}
+			}
+		}
+	}
+
+	template <typename T>
+	class View {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+		static_assert(!_internal_hasEncodedLeaves<T>(), "View cannot read data members with ATTR encodings, deserialize the object instead.");
+
+	public:
+		explicit View(std::span<const std::byte> bytes) : data{ bytes } {}
+
+		template <std::size_t N>
+		auto get() const {
+			static_assert(N < getNumberOfFields<T>(), "Data member index out of range.");
+
+			using Type = typename query::FieldDataType<N, T>::type;
+
+			std::optional<std::size_t> const offset = fieldOffset<N>();
+
+			if constexpr (isReflectable<Type>()) {
+				// a truncated object gives an empty view, so reads through it fail as well.
+				return View<Type>{ offset ? data.subspan(*offset) : std::span<const std::byte>{} };
+			}
+			else if constexpr (std::is_trivially_copyable_v<Type>) {
+				if (!offset || data.size() - *offset < sizeof(Type)) {
+					return std::optional<Type>{};
+				}
+
+				Type value;
+				std::memcpy(std::addressof(value), data.data() + *offset, sizeof(Type));
+				return std::optional<Type>{ value };
+			}
+			else if constexpr (std::same_as<std::ranges::range_value_t<Type>, char> && std::ranges::contiguous_range<Type>) {
+				if (!offset) {
+					return std::optional<std::string_view>{};
+				}
+
+				_internal_BinaryReader reader { data, *offset };
+				std::uint64_t size = 0;
+
+				if (!reader.read(&size, sizeof(size)) || size > reader.remaining()) {
+					return std::optional<std::string_view>{};
+				}
+
+				std::byte const* characters = reader.consume(static_cast<std::size_t>(size));
+				return std::optional<std::string_view>{ std::in_place, reinterpret_cast<char const*>(characters), static_cast<std::size_t>(size) };
+			}
+			else {
+				if (!offset) {
+					return std::optional<Type>{};
+				}
+
+				_internal_BinaryReader reader { data, *offset };
+				Type value {};
+				_internal_deserializeValue(reader, value);
+
+				return reader.failed ? std::optional<Type>{} : std::optional<Type>{ std::move(value) };
+			}
+		}
+
+		template <FixedString Name>
+		auto get() const {
+			constexpr std::size_t index = indexOf<T>(Name.view());
+			static_assert(index < getNumberOfFields<T>(), "Class has no reflected data member with this name.");
+
+			return get<index>();
+		}
+
+		std::span<const std::byte> bytes() const {
+			return data;
+		}
+
+	private:
+		// Position of data member N within data, or nothing if the bytes end before it.
+		template <std::size_t N>
+		std::optional<std::size_t> fieldOffset() const {
+			constexpr std::size_t prefix = _internal_fixedSizePrefix<T>();
+
+			if constexpr (N <= prefix) {
+				constexpr std::size_t offset = _internal_packedFieldOffset<T, N>();
+
+				if (offset > data.size()) {
+					return std::nullopt;
+				}
+
+				return offset;
+			}
+			else {
+				constexpr std::size_t start = _internal_packedFieldOffset<T, prefix>();
+
+				if (start > data.size()) {
+					return std::nullopt;
+				}
+
+				// skip over the data members between the last known position and this data member.
+				_internal_BinaryReader reader { data, start };
+
+				[&]<std::size_t... ints>(std::index_sequence<ints...>) {
+					(_internal_skipValue<typename query::FieldDataType<prefix + ints, T>::type>(reader), ...);
+				}(std::make_index_sequence<N - prefix>());
+
+				if (reader.failed) {
+					return std::nullopt;
+				}
+
+				return reader.position;
+			}
+		}
+
+		std::span<const std::byte> data;
+	};
+}
+
+/*!========================================================================
+	Struct of arrays container
+========================================================================*/
+namespace reflection {
+	// Column of bool leaves. std::vector<bool> packs its elements into bits, so it has no data() a span can view and no bool& to hand out.
+	class _internal_BoolColumn {
+	public:
+		_internal_BoolColumn() = default;
+
+		_internal_BoolColumn(_internal_BoolColumn const& other) {
+			*this = other;
+		}
+
+		_internal_BoolColumn(_internal_BoolColumn&& other) noexcept {
+			*this = std::move(other);
+		}
+
+		_internal_BoolColumn& operator=(_internal_BoolColumn const& other) {
+			if (this != &other) {
+				count = 0;
+				reserve(other.count);
+				std::copy_n(other.values.get(), other.count, values.get());
+				count = other.count;
+			}
+
+			return *this;
+		}
+
+		_internal_BoolColumn& operator=(_internal_BoolColumn&& other) noexcept {
+			values = std::move(other.values);
+			count = std::exchange(other.count, 0);
+			capacity = std::exchange(other.capacity, 0);
+			return *this;
+		}
+
+		void push_back(bool value) {
+			if (count == capacity) {
+				reallocate(capacity ? capacity * 2 : 8);
+			}
+
+			values[count++] = value;
+		}
+
+		void reserve(std::size_t size) {
+			if (size > capacity) {
+				reallocate(size);
+			}
+		}
+
+		void resize(std::size_t size) {
+			reserve(size);
+
+			if (size > count) {
+				std::fill(values.get() + count, values.get() + size, false);
+			}
+
+			count = size;
+		}
+
+		void clear() {
+			count = 0;
+		}
+
+		std::size_t size() const {
+			return count;
+		}
+
+		bool* data() {
+			return values.get();
+		}
+
+		bool const* data() const {
+			return values.get();
+		}
+
+		bool* begin() {
+			return values.get();
+		}
+
+		bool const* begin() const {
+			return values.get();
+		}
+
+		bool* end() {
+			return values.get() + count;
+		}
+
+		bool const* end() const {
+			return values.get() + count;
+		}
+
+		bool& operator[](std::size_t index) {
+			return values[index];
+		}
+
+		bool const& operator[](std::size_t index) const {
+			return values[index];
+		}
+
+	private:
+		void reallocate(std::size_t size) {
+			std::unique_ptr<bool[]> larger { new bool[size] };
+			std::copy_n(values.get(), count, larger.get());
+			values = std::move(larger);
+			capacity = size;
+		}
+
+		std::unique_ptr<bool[]> values;
+		std::size_t count = 0;
+		std::size_t capacity = 0;
+	};
+
+	template <typename List>
+	struct _internal_columns;
+
+	template <typename... Ts>
+	struct _internal_columns<TypeList<Ts...>> {
+		static_assert((!std::is_array_v<Ts> && ...), "Array data members cannot be stored in a SoaVector, use std::array instead.");
+
+		using type = std::tuple<std::conditional_t<std::same_as<Ts, bool>, _internal_BoolColumn, std::vector<Ts>>...>;
+	};
+
+	template <typename T>
+	class SoaVector {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		using Columns = typename _internal_columns<LeafTypes<T>>::type;
+
+		template <typename Vector>
+		class Proxy {
+		public:
+			Proxy(Vector& vector, std::size_t index) : vector{ vector }, index{ index } {}
+
+			template <std::size_t N>
+			auto& get() const {
+				return vector.template column<N>()[index];
+			}
+
+			template <FixedString Name>
+			auto& get() const {
+				return vector.template column<Name>()[index];
+			}
+
+			operator T() const {
+				T value {};
+				_internal_visitLeaves(value, [&]<std::size_t I, typename U>(std::integral_constant<std::size_t, I>, U& leaf) {
+					leaf = get<I>();
+				});
+				return value;
+			}
+
+			Proxy const& operator=(T const& value) const requires(!std::is_const_v<Vector>) {
+				_internal_visitLeaves(value, [&]<std::size_t I, typename U>(std::integral_constant<std::size_t, I>, U const& leaf) {
+					get<I>() = leaf;
+				});
+				return *this;
+			}
+
+		private:
+			Vector& vector;
+			std::size_t index;
+		};
+
+	public:
+		using Reference = Proxy<SoaVector>;
+		using ConstReference = Proxy<SoaVector const>;
+
+		void push_back(T const& value) {
+			_internal_visitLeaves(value, [&]<std::size_t I, typename U>(std::integral_constant<std::size_t, I>, U const& leaf) {
+				std::get<I>(columns).push_back(leaf);
+			});
+		}
+
+		void reserve(std::size_t capacity) {
+			std::apply([&](auto&... column) { (column.reserve(capacity), ...); }, columns);
+		}
+
+		void resize(std::size_t size) {
+			std::apply([&](auto&... column) { (column.resize(size), ...); }, columns);
+		}
+
+		void clear() {
+			std::apply([](auto&... column) { (column.clear(), ...); }, columns);
+		}
+
+		std::size_t size() const {
+			return std::get<0>(columns).size();
+		}
+
+		bool empty() const {
+			return size() == 0;
+		}
+
+		Reference operator[](std::size_t index) {
+			return { *this, index };
+		}
+
+		ConstReference operator[](std::size_t index) const {
+			return { *this, index };
+		}
+
+		// Column of leaf N, in visit order.
+		template <std::size_t N>
+		auto column() {
+			return std::span{ std::get<N>(columns) };
+		}
+
+		template <std::size_t N>
+		auto column() const {
+			return std::span{ std::get<N>(columns) };
+		}
+
+		template <FixedString Name>
+		auto column() {
+			return column<checkedLeafIndex<Name>()>();
+		}
+
+		template <FixedString Name>
+		auto column() const {
+			return column<checkedLeafIndex<Name>()>();
+		}
+
+	private:
+		template <FixedString Name>
+		static constexpr std::size_t checkedLeafIndex() {
+			constexpr std::size_t index = _internal_leafIndex<T>(Name.view());
+			static_assert(index < getNumberOfLeaves<T>(), "Class has no reflected leaf with this name. Nested data members are named by their path, pt1.x");
+
+			return index;
+		}
+
+		Columns columns;
+	};
+}
+
+/*!========================================================================
+	Bulk operations over SoaVector columns
+========================================================================*/
+namespace reflection {
+	class Bitmask {
+	public:
+		explicit Bitmask(std::size_t size) : bits{ size }, blocks((size + 63) / 64) {}
+
+		bool test(std::size_t index) const {
+			return (blocks[index / 64] >> (index % 64)) & 1;
+		}
+
+		void set(std::size_t index) {
+			blocks[index / 64] |= std::uint64_t{ 1 } << (index % 64);
+		}
+
+		// Ors mask into the bits starting at index. The bits of mask must not cross into the next 64 bit word.
+		void setBlock(std::size_t index, std::uint64_t mask) {
+			blocks[index / 64] |= mask << (index % 64);
+		}
+
+		std::size_t count() const {
+			std::size_t total = 0;
+
+			for (std::uint64_t block : blocks) {
+				total += static_cast<std::size_t>(std::popcount(block));
+			}
+
+			return total;
+		}
+
+		std::size_t size() const {
+			return bits;
+		}
+
+		std::span<const std::uint64_t> words() const {
+			return blocks;
+		}
+
+	private:
+		std::size_t bits;
+		std::vector<std::uint64_t> blocks;
+	};
+
+	template <typename T>
+	void _internal_compareEq(std::span<const T> column, T const& value, Bitmask& mask) {
+		std::size_t i = 0;
+
+#if defined(REFLECTION_AVX2)
+		if constexpr (std::same_as<T, float>) {
+			__m256 const needle = _mm256_set1_ps(value);
+
+			for (; i + 8 <= column.size(); i += 8) {
+				__m256 const equal = _mm256_cmp_ps(_mm256_loadu_ps(column.data() + i), needle, _CMP_EQ_OQ);
+				mask.setBlock(i, static_cast<std::uint32_t>(_mm256_movemask_ps(equal)));
+			}
+		}
+		else if constexpr (std::same_as<T, double>) {
+			__m256d const needle = _mm256_set1_pd(value);
+
+			for (; i + 4 <= column.size(); i += 4) {
+				__m256d const equal = _mm256_cmp_pd(_mm256_loadu_pd(column.data() + i), needle, _CMP_EQ_OQ);
+				mask.setBlock(i, static_cast<std::uint32_t>(_mm256_movemask_pd(equal)));
+			}
+		}
+		else if constexpr (std::integral<T> && sizeof(T) == 4) {
+			__m256i const needle = _mm256_set1_epi32(static_cast<int>(value));
+
+			for (; i + 8 <= column.size(); i += 8) {
+				__m256i const equal = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(column.data() + i)), needle);
+				mask.setBlock(i, static_cast<std::uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(equal))));
+			}
+		}
+		else if constexpr (std::integral<T> && sizeof(T) == 8) {
+			__m256i const needle = _mm256_set1_epi64x(static_cast<long long>(value));
+
+			for (; i + 4 <= column.size(); i += 4) {
+				__m256i const equal = _mm256_cmpeq_epi64(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(column.data() + i)), needle);
+				mask.setBlock(i, static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(equal))));
+			}
+		}
+#elif defined(REFLECTION_NEON)
+		// each lane keeps its own bit, adding the lanes together gives the mask.
+		if constexpr (std::same_as<T, float> || (std::integral<T> && sizeof(T) == 4)) {
+			alignas(16) static constexpr std::uint32_t laneBits[4] = { 1, 2, 4, 8 };
+			uint32x4_t const bits = vld1q_u32(laneBits);
+
+			for (; i + 4 <= column.size(); i += 4) {
+				uint32x4_t equal;
+
+				if constexpr (std::same_as<T, float>) {
+					equal = vceqq_f32(vld1q_f32(column.data() + i), vdupq_n_f32(value));
+				}
+				else {
+					equal = vceqq_u32(vld1q_u32(reinterpret_cast<std::uint32_t const*>(column.data() + i)), vdupq_n_u32(static_cast<std::uint32_t>(value)));
+				}
+
+				mask.setBlock(i, vaddvq_u32(vandq_u32(equal, bits)));
+			}
+		}
+		else if constexpr (std::same_as<T, double> || (std::integral<T> && sizeof(T) == 8)) {
+			alignas(16) static constexpr std::uint64_t laneBits[2] = { 1, 2 };
+			uint64x2_t const bits = vld1q_u64(laneBits);
+
+			for (; i + 2 <= column.size(); i += 2) {
+				uint64x2_t equal;
+
+				if constexpr (std::same_as<T, double>) {
+					equal = vceqq_f64(vld1q_f64(column.data() + i), vdupq_n_f64(value));
+				}
+				else {
+					equal = vceqq_u64(vld1q_u64(reinterpret_cast<std::uint64_t const*>(column.data() + i)), vdupq_n_u64(static_cast<std::uint64_t>(value)));
+				}
+
+				mask.setBlock(i, vaddvq_u64(vandq_u64(equal, bits)));
+			}
+		}
+#endif
+
+		for (; i < column.size(); ++i) {
+			if (column[i] == value) {
+				mask.set(i);
+			}
+		}
+	}
+
+	template <typename T, typename BinaryOp>
+	T _internal_reduce(std::span<const T> column, T init, BinaryOp& op) {
+		std::size_t i = 0;
+
+#if defined(REFLECTION_AVX2) || defined(REFLECTION_NEON)
+		constexpr bool isSum = std::same_as<BinaryOp, std::plus<>> || std::same_as<BinaryOp, std::plus<T>>;
+#endif
+
+#if defined(REFLECTION_AVX2)
+		if constexpr (isSum && std::same_as<T, float>) {
+			__m256 sum = _mm256_setzero_ps();
+
+			for (; i + 8 <= column.size(); i += 8) {
+				sum = _mm256_add_ps(sum, _mm256_loadu_ps(column.data() + i));
+			}
+
+			alignas(32) float lanes[8];
+			_mm256_store_ps(lanes, sum);
+
+			for (float lane : lanes) {
+				init += lane;
+			}
+		}
+		else if constexpr (isSum && std::same_as<T, double>) {
+			__m256d sum = _mm256_setzero_pd();
+
+			for (; i + 4 <= column.size(); i += 4) {
+				sum = _mm256_add_pd(sum, _mm256_loadu_pd(column.data() + i));
+			}
+
+			alignas(32) double lanes[4];
+			_mm256_store_pd(lanes, sum);
+
+			for (double lane : lanes) {
+				init += lane;
+			}
+		}
+		else if constexpr (isSum && std::integral<T> && sizeof(T) == 4) {
+			__m256i sum = _mm256_setzero_si256();
+
+			for (; i + 8 <= column.size(); i += 8) {
+				sum = _mm256_add_epi32(sum, _mm256_loadu_si256(reinterpret_cast<__m256i const*>(column.data() + i)));
+			}
+
+			alignas(32) T lanes[8];
+			_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum);
+
+			for (T lane : lanes) {
+				init = static_cast<T>(init + lane);
+			}
+		}
+		else if constexpr (isSum && std::integral<T> && sizeof(T) == 8) {
+			__m256i sum = _mm256_setzero_si256();
+
+			for (; i + 4 <= column.size(); i += 4) {
+				sum = _mm256_add_epi64(sum, _mm256_loadu_si256(reinterpret_cast<__m256i const*>(column.data() + i)));
+			}
+
+			alignas(32) T lanes[4];
+			_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum);
+
+			for (T lane : lanes) {
+				init = static_cast<T>(init + lane);
+			}
+		}
+#elif defined(REFLECTION_NEON)
+		if constexpr (isSum && std::same_as<T, float>) {
+			float32x4_t sum = vdupq_n_f32(0.f);
+
+			for (; i + 4 <= column.size(); i += 4) {
+				sum = vaddq_f32(sum, vld1q_f32(column.data() + i));
+			}
+
+			init += vaddvq_f32(sum);
+		}
+		else if constexpr (isSum && std::same_as<T, double>) {
+			float64x2_t sum = vdupq_n_f64(0.0);
+
+			for (; i + 2 <= column.size(); i += 2) {
+				sum = vaddq_f64(sum, vld1q_f64(column.data() + i));
+			}
+
+			init += vaddvq_f64(sum);
+		}
+		else if constexpr (isSum && std::integral<T> && sizeof(T) == 4) {
+			uint32x4_t sum = vdupq_n_u32(0);
+
+			for (; i + 4 <= column.size(); i += 4) {
+				sum = vaddq_u32(sum, vld1q_u32(reinterpret_cast<std::uint32_t const*>(column.data() + i)));
+			}
+
+			init = static_cast<T>(init + static_cast<T>(vaddvq_u32(sum)));
+		}
+		else if constexpr (isSum && std::integral<T> && sizeof(T) == 8) {
+			uint64x2_t sum = vdupq_n_u64(0);
+
+			for (; i + 2 <= column.size(); i += 2) {
+				sum = vaddq_u64(sum, vld1q_u64(reinterpret_cast<std::uint64_t const*>(column.data() + i)));
+			}
+
+			init = static_cast<T>(init + static_cast<T>(vaddvq_u64(sum)));
+		}
+#endif
+
+		// independent accumulators break up the dependency chain and let the compiler vectorize any other operation.
+		if (column.size() - i >= 4) {
+			T accumulators[4] = { column[i], column[i + 1], column[i + 2], column[i + 3] };
+
+			for (i += 4; i + 4 <= column.size(); i += 4) {
+				for (std::size_t lane = 0; lane < 4; ++lane) {
+					accumulators[lane] = op(accumulators[lane], column[i + lane]);
+				}
+			}
+
+			init = op(init, op(op(accumulators[0], accumulators[1]), op(accumulators[2], accumulators[3])));
+		}
+
+		for (; i < column.size(); ++i) {
+			init = op(init, column[i]);
+		}
+
+		return init;
+	}
+
+	template <FixedString Name, typename T, typename Functor>
+	void transform(SoaVector<T>& soa, Functor&& func) {
+		// columns are contiguous and func is visible to the optimizer, so this vectorizes wherever func allows it.
+		for (auto& element : soa.template column<Name>()) {
+			element = func(element);
+		}
+	}
+
+	template <FixedString Name, typename T, typename U, typename BinaryOp>
+	U reduce(SoaVector<T> const& soa, U init, BinaryOp op) {
+		using Element = typename decltype(soa.template column<Name>())::value_type;
+
+		if constexpr (std::same_as<U, Element> && std::is_arithmetic_v<U>) {
+			return _internal_reduce<Element>(soa.template column<Name>(), init, op);
+		}
+		else {
+			for (auto const& element : soa.template column<Name>()) {
+				init = op(std::move(init), element);
+			}
+
+			return init;
+		}
+	}
+
+	template <FixedString Name, typename T, typename U>
+	Bitmask compareEq(SoaVector<T> const& soa, U const& value) {
+		using Element = typename decltype(soa.template column<Name>())::value_type;
+		static_assert(requires { Element{ value }; }, "Value must convert to the column type without narrowing, 2.5 would otherwise match 2 in an int column.");
+
+		Bitmask mask { soa.size() };
+		_internal_compareEq<Element>(soa.template column<Name>(), Element{ value }, mask);
+		return mask;
+	}
+}
+
+/*!========================================================================
+	Text formatting
+========================================================================*/
+namespace reflection {
+	// Stream buffer writing straight to an output iterator, for data members only formattable through operator<<.
+	template <typename OutputIt>
+	class _internal_OutputIteratorBuffer : public std::streambuf {
+	public:
+		explicit _internal_OutputIteratorBuffer(OutputIt& out) : out{ out } {}
+
+	protected:
+		int_type overflow(int_type character) override {
+			if (!traits_type::eq_int_type(character, traits_type::eof())) {
+				*out++ = traits_type::to_char_type(character);
+			}
+
+			return traits_type::not_eof(character);
+		}
+
+		std::streamsize xsputn(char const* characters, std::streamsize count) override {
+			out = std::copy_n(characters, count, out);
+			return count;
+		}
+
+	private:
+		OutputIt& out;
+	};
+
+	// Counts characters and drops them once limit is reached, used by formatToN.
+	template <typename OutputIt>
+	struct _internal_LimitedOutput {
+		using iterator_category = std::output_iterator_tag;
+		using value_type = void;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = void;
+
+		OutputIt* out;
+		std::size_t* size;
+		std::size_t limit;
+
+		_internal_LimitedOutput& operator=(char character) {
+			if (*size < limit) {
+				*(*out)++ = character;
+			}
+
+			++*size;
+			return *this;
+		}
+
+		_internal_LimitedOutput& operator*() { return *this; }
+		_internal_LimitedOutput& operator++() { return *this; }
+		_internal_LimitedOutput operator++(int) { return *this; }
+	};
+
+	// Collects characters in a fixed size buffer and writes them to a stream a chunk at a time, used by print and prettyPrint.
+	struct _internal_ChunkedStream {
+		explicit _internal_ChunkedStream(std::ostream& stream) : stream{ stream } {}
+
+		std::ostream& stream;
+		char buffer[4096];
+		std::size_t size = 0;
+
+		void flush() {
+			stream.write(buffer, static_cast<std::streamsize>(size));
+			size = 0;
+		}
+
+		~_internal_ChunkedStream() {
+			flush();
+		}
+	};
+
+	struct _internal_ChunkedOutput {
+		using iterator_category = std::output_iterator_tag;
+		using value_type = void;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = void;
+
+		_internal_ChunkedStream* chunks;
+
+		_internal_ChunkedOutput& operator=(char character) {
+			if (chunks->size == sizeof(chunks->buffer)) {
+				chunks->flush();
+			}
+
+			chunks->buffer[chunks->size++] = character;
+			return *this;
+		}
+
+		_internal_ChunkedOutput& operator*() { return *this; }
+		_internal_ChunkedOutput& operator++() { return *this; }
+		_internal_ChunkedOutput operator++(int) { return *this; }
+	};
+
+	template <typename OutputIt>
+	OutputIt _internal_write(OutputIt out, std::string_view string) {
+		return std::copy(string.begin(), string.end(), out);
+	}
+
+	template <typename OutputIt>
+	OutputIt _internal_indent(OutputIt out, FormatOptions const& options, int depth) {
+		return options.pretty ? std::fill_n(out, options.indentWidth * depth, ' ') : out;
+	}
+
+	template <typename OutputIt, typename T>
+	OutputIt _internal_formatValue(OutputIt out, T const& value) {
+		if constexpr (isReflectable<T>()) {
+			return formatTo(out, value);
+		}
+		else if constexpr (std::same_as<T, bool>) {
+			return _internal_write(out, value ? "true" : "false");
+		}
+		else if constexpr (std::same_as<T, char>) {
+			*out++ = value;
+			return out;
+		}
+		else if constexpr (std::is_arithmetic_v<T>) {
+			char characters[64];
+			auto const result = std::to_chars(characters, characters + sizeof(characters), value);
+			return std::copy(characters, result.ptr, out);
+		}
+		else if constexpr (std::is_enum_v<T>) {
+			return _internal_formatValue(out, static_cast<std::underlying_type_t<T>>(value));
+		}
+		else if constexpr (std::convertible_to<T const&, std::string_view>) {
+			return _internal_write(out, std::string_view{ value });
+		}
+		else if constexpr (std::ranges::input_range<T const>) {
+			*out++ = '[';
+			bool first = true;
+
+			for (auto const& element : value) {
+				if (!first) {
+					out = _internal_write(out, ", ");
+				}
+
+				out = _internal_formatValue(out, element);
+				first = false;
+			}
+
+			*out++ = ']';
+			return out;
+		}
+		else if constexpr (_internal_pairLike<T>) {
+			*out++ = '(';
+			out = _internal_formatValue(out, value.first);
+			out = _internal_write(out, ", ");
+			out = _internal_formatValue(out, value.second);
+			*out++ = ')';
+			return out;
+		}
+		else if constexpr (requires (std::ostream& stream) { stream << value; }) {
+			_internal_OutputIteratorBuffer<OutputIt> buffer { out };
+			std::ostream stream { &buffer };
+			stream << value;
+			return out;
+		}
+		else {
+			static_assert(sizeof(T) == 0, "Data member is not formattable! It must be arithmetic, a string, a range, reflectable or overload operator<<.");
+		}
+	}
+
+	template <typename OutputIt, typename T>
+	OutputIt formatTo(OutputIt out, T const& x, FormatOptions options) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		int recursionDepth = 0;
+		bool first = true;
+
+		// every data member and nested object is followed by a separator in pretty mode, and preceded by one otherwise.
+		auto separate = [&] {
+			if (!options.pretty && !first) {
+				out = _internal_write(out, ", ");
+			}
+
+			first = false;
+		};
+
+		out = _internal_write(out, options.pretty ? "{\n" : "{ ");
+
+		visit(
+			[&](auto fieldData) {
+				separate();
+				out = _internal_indent(out, options, recursionDepth + 1);
+				out = _internal_write(out, fieldData.name());
+				out = _internal_write(out, " = ");
+				out = _internal_formatValue(out, fieldData.get());
+
+				if (options.pretty) {
+					out = _internal_write(out, ",\n");
+				}
+			},
+			[&] {
+				separate();
+				++recursionDepth;
+				out = _internal_indent(out, options, recursionDepth);
+				out = _internal_write(out, options.pretty ? "{\n" : "{ ");
+				first = true;
+			},
+			[&] {
+				out = _internal_indent(out, options, recursionDepth);
+				out = _internal_write(out, options.pretty ? "},\n" : " }");
+				--recursionDepth;
+				first = false;
+			},
+			x
+		);
+
+		return _internal_write(out, options.pretty ? "}" : " }");
+	}
+
+	template <typename OutputIt, typename T>
+	FormatToNResult<OutputIt> formatToN(OutputIt out, std::size_t n, T const& x, FormatOptions options) {
+		std::size_t size = 0;
+		formatTo(_internal_LimitedOutput<OutputIt>{ &out, &size, n }, x, options);
+		return { out, size };
+	}
+
+	template <typename T>
+	void print(T&& x) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		_internal_ChunkedStream chunks { std::cout };
+		*formatTo(_internal_ChunkedOutput{ &chunks }, x) = '\n';
+	}
+
+	template <typename T>
+	void prettyPrint(T&& x) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		_internal_ChunkedStream chunks { std::cout };
+		*formatTo(_internal_ChunkedOutput{ &chunks }, x, FormatOptions{ .pretty = true }) = '\n';
+	}
+}
+
+/*!========================================================================
+	JSON
+========================================================================*/
+namespace reflection::json {
+	// First character in [begin, end) that is a quote, a backslash or, if Control is set, a control character. end if there is none.
+	template <bool Control>
+	char const* _internal_findSpecial(char const* begin, char const* end) {
+#if defined(REFLECTION_AVX2)
+		__m256i const quote = _mm256_set1_epi8('"');
+		__m256i const backslash = _mm256_set1_epi8('\\');
+		__m256i const lastControl = _mm256_set1_epi8(0x1F);
+
+		for (; end - begin >= 32; begin += 32) {
+			__m256i const characters = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(begin));
+			__m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(characters, quote), _mm256_cmpeq_epi8(characters, backslash));
+
+			if constexpr (Control) {
+				// unsigned characters <= 0x1F, max(c, 0x1F) == 0x1F.
+				special = _mm256_or_si256(special, _mm256_cmpeq_epi8(_mm256_max_epu8(characters, lastControl), lastControl));
+			}
+
+			if (std::uint32_t const mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(special))) {
+				return begin + std::countr_zero(mask);
+			}
+		}
+#elif defined(REFLECTION_SSE2)
+		__m128i const quote = _mm_set1_epi8('"');
+		__m128i const backslash = _mm_set1_epi8('\\');
+		__m128i const lastControl = _mm_set1_epi8(0x1F);
+
+		for (; end - begin >= 16; begin += 16) {
+			__m128i const characters = _mm_loadu_si128(reinterpret_cast<__m128i const*>(begin));
+			__m128i special = _mm_or_si128(_mm_cmpeq_epi8(characters, quote), _mm_cmpeq_epi8(characters, backslash));
+
+			if constexpr (Control) {
+				special = _mm_or_si128(special, _mm_cmpeq_epi8(_mm_max_epu8(characters, lastControl), lastControl));
+			}
+
+			if (std::uint32_t const mask = static_cast<std::uint32_t>(_mm_movemask_epi8(special))) {
+				return begin + std::countr_zero(mask);
+			}
+		}
+#elif defined(REFLECTION_NEON)
+		for (; end - begin >= 16; begin += 16) {
+			uint8x16_t const characters = vld1q_u8(reinterpret_cast<std::uint8_t const*>(begin));
+			uint8x16_t special = vorrq_u8(vceqq_u8(characters, vdupq_n_u8('"')), vceqq_u8(characters, vdupq_n_u8('\\')));
+
+			if constexpr (Control) {
+				special = vorrq_u8(special, vcltq_u8(characters, vdupq_n_u8(0x20)));
+			}
+
+			// narrowing shift packs the 16 byte mask into 4 bits per byte.
+			std::uint64_t const mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(special), 4)), 0);
+
+			if (mask) {
+				return begin + (std::countr_zero(mask) >> 2);
+			}
+		}
+#endif
+
+		for (; begin != end; ++begin) {
+			unsigned char const character = static_cast<unsigned char>(*begin);
+
+			if (character == '"' || character == '\\' || (Control && character < 0x20)) {
+				return begin;
+			}
+		}
+
+		return end;
+	}
+
+	template <typename T>
+	concept _internal_stringLike = std::convertible_to<T const&, std::string_view>;
+
+	// Range of pairs keyed by strings, written as a JSON object.
+	template <typename T>
+	concept _internal_stringKeyed = std::ranges::input_range<T const> && _internal_pairLike<std::ranges::range_value_t<T const>>
+		&& _internal_stringLike<std::remove_const_t<typename std::ranges::range_value_t<T const>::first_type>>;
+
+	template <ByteBuffer Buffer>
+	struct _internal_Writer : _internal_BinaryWriter<Buffer> {
+		void put(char character) {
+			*this->reserve(1) = static_cast<std::byte>(character);
+		}
+
+		void put(std::string_view string) {
+			this->write(string.data(), string.size());
+		}
+
+		void putString(std::string_view string) {
+			static constexpr char hexDigits[] = "0123456789abcdef";
+
+			put('"');
+
+			char const* position = string.data();
+			char const* const end = position + string.size();
+
+			// copy runs of plain characters at once, escaping only the special ones.
+			while (position != end) {
+				char const* const special = _internal_findSpecial<true>(position, end);
+				this->write(position, static_cast<std::size_t>(special - position));
+
+				if (special == end) {
+					break;
+				}
+
+				unsigned char const character = static_cast<unsigned char>(*special);
+
+				switch (character) {
+				case '"':	put("\\\""); break;
+				case '\\':	put("\\\\"); break;
+				case '\n':	put("\\n"); break;
+				case '\r':	put("\\r"); break;
+				case '\t':	put("\\t"); break;
+				case '\b':	put("\\b"); break;
+				case '\f':	put("\\f"); break;
+				default: {
+					char const escaped[] = { '\\', 'u', '0', '0', hexDigits[character >> 4], hexDigits[character & 0xF] };
+					this->write(escaped, sizeof(escaped));
+				}
+				}
+
+				position = special + 1;
+			}
+
+			put('"');
+		}
+	};
+
+	template <typename Writer, typename T>
+	void _internal_writeValue(Writer& writer, T const& value);
+
+	template <typename Writer, typename T>
+	void _internal_writeObject(Writer& writer, T const& x) {
+		writer.put('{');
+		bool first = true;
+
+		iterateThroughMember(x, [&](auto fieldData) {
+			if constexpr (decltype(fieldData)::attributes().skip) {
+				return;
+			}
+
+			if (!first) {
+				writer.put(',');
+			}
+
+			writer.putString(fieldData.name());
+			writer.put(':');
+			_internal_writeValue(writer, fieldData.get());
+			first = false;
+		});
+
+		writer.put('}');
+	}
+
+	template <typename Writer, typename T>
+	void _internal_writeValue(Writer& writer, T const& value) {
+		if constexpr (isReflectable<T>()) {
+			_internal_writeObject(writer, value);
+		}
+		else if constexpr (std::same_as<T, bool>) {
+			writer.put(value ? "true" : "false");
+		}
+		else if constexpr (std::same_as<T, char>) {
+			writer.putString(std::string_view{ &value, 1 });
+		}
+		else if constexpr (std::is_arithmetic_v<T>) {
+			if constexpr (std::is_floating_point_v<T>) {
+				if (value != value || value - value != value - value) {
+					writer.put("null");
+					return;
+				}
+			}
+
+			char characters[64];
+			auto const result = std::to_chars(characters, characters + sizeof(characters), value);
+			writer.write(characters, static_cast<std::size_t>(result.ptr - characters));
+		}
+		else if constexpr (std::is_enum_v<T>) {
+			_internal_writeValue(writer, static_cast<std::underlying_type_t<T>>(value));
+		}
+		else if constexpr (_internal_stringLike<T>) {
+			writer.putString(std::string_view{ value });
+		}
+		else if constexpr (_internal_stringKeyed<T>) {
+			writer.put('{');
+			bool first = true;
+
+			for (auto const& [key, element] : value) {
+				if (!first) {
+					writer.put(',');
+				}
+
+				writer.putString(std::string_view{ key });
+				writer.put(':');
+				_internal_writeValue(writer, element);
+				first = false;
+			}
+
+			writer.put('}');
+		}
+		else if constexpr (std::ranges::input_range<T const>) {
+			writer.put('[');
+			bool first = true;
+
+			for (auto const& element : value) {
+				if (!first) {
+					writer.put(',');
+				}
+
+				_internal_writeValue(writer, element);
+				first = false;
+			}
+
+			writer.put(']');
+		}
+		else if constexpr (_internal_pairLike<T>) {
+			writer.put('[');
+			_internal_writeValue(writer, value.first);
+			writer.put(',');
+			_internal_writeValue(writer, value.second);
+			writer.put(']');
+		}
+		else {
+			static_assert(sizeof(T) == 0, "Data member cannot be written as JSON! It must be arithmetic, a string, a range, a pair or reflectable.");
+		}
+	}
+
+	template <typename T, ByteBuffer Buffer>
+	void write(T const& x, Buffer& buffer) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		_internal_Writer<Buffer> writer { { buffer } };
+		_internal_writeObject(writer, x);
+	}
+
+	struct _internal_Reader {
+		char const* position;
+		char const* end;
+		std::string scratch {};	// decoded strings containing escapes.
+		bool failed = false;
+
+		bool fail() {
+			failed = true;
+			return false;
+		}
+
+		static constexpr bool isWhitespace(char character) {
+			return character == ' ' || character == '\n' || character == '\r' || character == '\t';
+		}
+
+		void skipWhitespace() {
+			while (position != end && isWhitespace(*position)) {
+				++position;
+			}
+		}
+
+		// Skips whitespace and consumes character if it is next.
+		bool consume(char character) {
+			skipWhitespace();
+
+			if (position != end && *position == character) {
+				++position;
+				return true;
+			}
+
+			return false;
+		}
+
+		bool expect(char character) {
+			return consume(character) || fail();
+		}
+
+		bool consumeLiteral(std::string_view literal) {
+			skipWhitespace();
+
+			if (static_cast<std::size_t>(end - position) >= literal.size() && std::string_view{ position, literal.size() } == literal) {
+				position += literal.size();
+				return true;
+			}
+
+			return false;
+		}
+
+		// Characters of a number or literal, up to the next structural character or whitespace.
+		std::string_view token() {
+			skipWhitespace();
+			char const* const begin = position;
+
+			while (position != end && !isWhitespace(*position) && *position != ',' && *position != ']' && *position != '}' && *position != ':') {
+				++position;
+			}
+
+			return { begin, static_cast<std::size_t>(position - begin) };
+		}
+
+		static int hexValue(char character) {
+			if (character >= '0' && character <= '9') return character - '0';
+			if (character >= 'a' && character <= 'f') return character - 'a' + 10;
+			if (character >= 'A' && character <= 'F') return character - 'A' + 10;
+			return -1;
+		}
+
+		bool readCodeUnit(std::uint32_t& codeUnit) {
+			if (end - position < 4) {
+				return fail();
+			}
+
+			codeUnit = 0;
+
+			for (int i = 0; i < 4; ++i) {
+				int const digit = hexValue(*position++);
+
+				if (digit < 0) {
+					return fail();
+				}
+
+				codeUnit = (codeUnit << 4) | static_cast<std::uint32_t>(digit);
+			}
+
+			return true;
+		}
+
+		void appendUtf8(std::uint32_t codePoint) {
+			if (codePoint < 0x80) {
+				scratch += static_cast<char>(codePoint);
+			}
+			else if (codePoint < 0x800) {
+				scratch += static_cast<char>(0xC0 | (codePoint >> 6));
+				scratch += static_cast<char>(0x80 | (codePoint & 0x3F));
+			}
+			else if (codePoint < 0x10000) {
+				scratch += static_cast<char>(0xE0 | (codePoint >> 12));
+				scratch += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+				scratch += static_cast<char>(0x80 | (codePoint & 0x3F));
+			}
+			else {
+				scratch += static_cast<char>(0xF0 | (codePoint >> 18));
+				scratch += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+				scratch += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+				scratch += static_cast<char>(0x80 | (codePoint & 0x3F));
+			}
+		}
+
+		/*!***********************************************************************
+		* @brief
+		*	Reads a string. Strings without escapes are returned as a view into the
+		*	input, others are decoded into scratch and only valid until the next call.
+		**************************************************************************/
+		bool readString(std::string_view& string) {
+			if (!expect('"')) {
+				return false;
+			}
+
+			char const* special = _internal_findSpecial<false>(position, end);
+
+			if (special != end && *special == '"') {
+				string = { position, static_cast<std::size_t>(special - position) };
+				position = special + 1;
+				return true;
+			}
+
+			scratch.clear();
+
+			while (special != end) {
+				scratch.append(position, special);
+				position = special + 1;
+
+				if (*special == '"') {
+					string = scratch;
+					return true;
+				}
+
+				if (position == end) {
+					return fail();
+				}
+
+				switch (*position++) {
+				case '"':	scratch += '"'; break;
+				case '\\':	scratch += '\\'; break;
+				case '/':	scratch += '/'; break;
+				case 'n':	scratch += '\n'; break;
+				case 'r':	scratch += '\r'; break;
+				case 't':	scratch += '\t'; break;
+				case 'b':	scratch += '\b'; break;
+				case 'f':	scratch += '\f'; break;
+				case 'u': {
+					std::uint32_t codePoint = 0;
+
+					if (!readCodeUnit(codePoint)) {
+						return false;
+					}
+
+					// utf-16 surrogate pair.
+					if (codePoint >= 0xD800 && codePoint < 0xDC00 && end - position >= 6 && position[0] == '\\' && position[1] == 'u') {
+						position += 2;
+						std::uint32_t low = 0;
+
+						if (!readCodeUnit(low) || low < 0xDC00 || low >= 0xE000) {
+							return fail();
+						}
+
+						codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+					}
+
+					appendUtf8(codePoint);
+					break;
+				}
+				default:
+					return fail();
+				}
+
+				special = _internal_findSpecial<false>(position, end);
+			}
+
+			return fail();
+		}
+
+		bool skipString() {
+			std::string_view string;
+			return readString(string);
+		}
+
+		// Skips any value without recursing, so deeply nested input cannot overflow the stack.
+		bool skipValue() {
+			std::size_t depth = 0;
+
+			do {
+				skipWhitespace();
+
+				if (position == end) {
+					return fail();
+				}
+
+				switch (*position) {
+				case '"':
+					if (!skipString()) {
+						return false;
+					}
+					break;
+				case '{':
+				case '[':
+					++depth;
+					++position;
+					break;
+				case '}':
+				case ']':
+					if (depth == 0) {
+						return fail();
+					}
+					--depth;
+					++position;
+					break;
+				case ',':
+				case ':':
+					if (depth == 0) {
+						return fail();
+					}
+					++position;
+					break;
+				default:
+					if (token().empty()) {
+						return fail();
+					}
+				}
+			} while (depth > 0);
+
+			return true;
+		}
+	};
+
+	template <typename T>
+	bool _internal_readValue(_internal_Reader& reader, T& value);
+
+	template <typename T>
+	bool _internal_readObject(_internal_Reader& reader, T& x) {
+		if (!reader.expect('{')) {
+			return false;
+		}
+
+		if (reader.consume('}')) {
+			return true;
+		}
+
+		do {
+			std::string_view key;
+
+			if (!reader.readString(key) || !reader.expect(':')) {
+				return false;
+			}
+
+			bool const known = visitField(key, [&](auto fieldData) {
+				// skipped data members aren't written, so they are left untouched when read as well.
+				if constexpr (decltype(fieldData)::attributes().skip) {
+					reader.skipValue();
+				}
+				else {
+					_internal_readValue(reader, x.*decltype(fieldData)::getPointerToMember());
+				}
+			}, x);
+
+			if (!known) {
+				reader.skipValue();
+			}
+
+			if (reader.failed) {
+				return false;
+			}
+		} while (reader.consume(','));
+
+		return reader.expect('}');
+	}
+
+	template <typename T>
+	bool _internal_readValue(_internal_Reader& reader, T& value) {
+		if (reader.consumeLiteral("null")) {
+			return true;
+		}
+
+		if constexpr (isReflectable<T>()) {
+			return _internal_readObject(reader, value);
+		}
+		else if constexpr (std::same_as<T, bool>) {
+			if (reader.consumeLiteral("true")) {
+				value = true;
+			}
+			else if (reader.consumeLiteral("false")) {
+				value = false;
+			}
+			else {
+				return reader.fail();
+			}
+
+			return true;
+		}
+		else if constexpr (std::same_as<T, char>) {
+			std::string_view string;
+
+			if (!reader.readString(string) || string.size() != 1) {
+				return reader.fail();
+			}
+
+			value = string[0];
+			return true;
+		}
+		else if constexpr (std::is_arithmetic_v<T>) {
+			std::string_view const token = reader.token();
+			auto const result = std::from_chars(token.data(), token.data() + token.size(), value);
+
+			return (result.ec == std::errc{} && result.ptr == token.data() + token.size()) || reader.fail();
+		}
+		else if constexpr (std::is_enum_v<T>) {
+			std::underlying_type_t<T> underlying {};
+
+			if (!_internal_readValue(reader, underlying)) {
+				return false;
+			}
+
+			value = static_cast<T>(underlying);
+			return true;
+		}
+		else if constexpr (_internal_stringLike<T> && requires (std::string_view string) { value.assign(string.begin(), string.end()); }) {
+			std::string_view string;
+
+			if (!reader.readString(string)) {
+				return false;
+			}
+
+			value.assign(string.begin(), string.end());
+			return true;
+		}
+		else if constexpr (_internal_pairLike<T>) {
+			return reader.expect('[') && _internal_readValue(reader, value.first) && reader.expect(',') && _internal_readValue(reader, value.second) && reader.expect(']');
+		}
+		else if constexpr (std::ranges::input_range<T>) {
+			using Element = typename _internal_mutable<std::ranges::range_value_t<T const>>::type;
+			constexpr bool keyed = _internal_stringKeyed<T>;
+
+			if constexpr (requires (Element element) { value.clear(); value.push_back(std::move(element)); } || requires (Element element) { value.clear(); value.insert(std::move(element)); }) {
+				if (!reader.expect(keyed ? '{' : '[')) {
+					return false;
+				}
+
+				value.clear();
+
+				if (reader.consume(keyed ? '}' : ']')) {
+					return true;
+				}
+
+				do {
+					Element element {};
+
+					if constexpr (keyed) {
+						std::string_view key;
+
+						if (!reader.readString(key) || !reader.expect(':')) {
+							return false;
+						}
+
+						element.first = typename Element::first_type(key);
+
+						if (!_internal_readValue(reader, element.second)) {
+							return false;
+						}
+					}
+					else if (!_internal_readValue(reader, element)) {
+						return false;
+					}
+
+					if constexpr (requires { value.push_back(std::move(element)); }) {
+						value.push_back(std::move(element));
+					}
+					else {
+						value.insert(std::move(element));
+					}
+				} while (reader.consume(','));
+
+				return reader.expect(keyed ? '}' : ']');
+			}
+			else {
+				// fixed size ranges, like arrays, must receive exactly as many elements as they hold.
+				if (!reader.expect('[')) {
+					return false;
+				}
+
+				bool first = true;
+
+				for (auto& element : value) {
+					if ((!first && !reader.expect(',')) || !_internal_readValue(reader, element)) {
+						return false;
+					}
+
+					first = false;
+				}
+
+				return reader.expect(']');
+			}
+		}
+		else {
+			static_assert(sizeof(T) == 0, "Data member cannot be read from JSON! It must be arithmetic, a string, a range, a pair or reflectable.");
+		}
+	}
+
+	template <typename T>
+	bool read(std::string_view json, T& x) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		_internal_Reader reader { json.data(), json.data() + json.size() };
+
+		if (!_internal_readObject(reader, x)) {
+			return false;
+		}
+
+		reader.skipWhitespace();
+		return reader.position == reader.end;
+	}
+}
+
+/*!========================================================================
+	Delta serialization
+========================================================================*/
+namespace reflection {
+	// operator== of standard containers and pairs isn't constrained on their elements, so it is checked recursively.
+	template <typename T>
+	constexpr bool _internal_comparable() {
+		if constexpr (isReflectable<T>() || std::is_array_v<T> || !std::equality_comparable<T>) {
+			return false;
+		}
+		else if constexpr (_internal_pairLike<T>) {
+			return _internal_comparable<std::remove_const_t<typename T::first_type>>() && _internal_comparable<typename T::second_type>();
+		}
+		else if constexpr (std::ranges::range<T const>) {
+			return _internal_comparable<std::remove_cvref_t<std::ranges::range_value_t<T const>>>();
+		}
+		else {
+			return true;
+		}
+	}
+
+	template <typename T>
+	bool _internal_equal(T const& a, T const& b) {
+		if constexpr (isReflectable<T>()) {
+			return equal(a, b);
+		}
+		else if constexpr (std::is_array_v<T>) {
+			return std::equal(std::begin(a), std::end(a), std::begin(b), [](auto const& left, auto const& right) { return _internal_equal(left, right); });
+		}
+		else if constexpr (_internal_comparable<T>()) {
+			return a == b;
+		}
+		else if constexpr (_internal_pairLike<T>) {
+			return _internal_equal(a.first, b.first) && _internal_equal(a.second, b.second);
+		}
+		else if constexpr (std::ranges::forward_range<T const>) {
+			return std::ranges::equal(a, b, [](auto const& left, auto const& right) { return _internal_equal(left, right); });
+		}
+		else if constexpr (std::is_trivially_copyable_v<T>) {
+			// may report padding only differences as changes, which costs bytes but never loses one.
+			return std::memcmp(std::addressof(a), std::addressof(b), sizeof(T)) == 0;
+		}
+		else {
+			static_assert(sizeof(T) == 0, "Data member cannot be compared! It must be reflectable, equality comparable, a range or trivially copyable.");
+		}
+	}
+
+	// Whether data member N of T differs between before and after. T is a data member of Root whose leaves start at leaf Base of Root,
+	// which the attributes of the leaves are looked up in, so skipped leaves never count as changed.
+	template <typename Root, std::size_t Base, std::size_t N, typename T>
+	bool _internal_fieldChanged(T const& before, T const& after) {
+		using Field = typename query::FieldDataType<N, T>::type;
+		constexpr std::size_t leaf = Base + _internal_leafStarts<T>[N];
+
+		auto const& oldValue = before.*query::FieldDataType<N, T>::getPointerToMember();
+		auto const& newValue = after.*query::FieldDataType<N, T>::getPointerToMember();
+
+		if constexpr (isReflectable<Field>()) {
+			return [&]<std::size_t... ints>(std::index_sequence<ints...>) {
+				return (... || _internal_fieldChanged<Root, leaf, ints>(oldValue, newValue));
+			}(std::make_index_sequence<getNumberOfFields<Field>()>());
+		}
+		else if constexpr (_internal_leaves<Root>[leaf].attributes.skip) {
+			return false;
+		}
+		else {
+			return !_internal_equal(oldValue, newValue);
+		}
+	}
+
+	template <typename T>
+	std::bitset<getNumberOfFields<T>()> diff(T const& before, T const& after) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		std::bitset<getNumberOfFields<T>()> changed;
+
+		[&]<std::size_t... ints>(std::index_sequence<ints...>) {
+			(changed.set(ints, _internal_fieldChanged<T, 0, ints>(before, after)), ...);
+		}(std::make_index_sequence<getNumberOfFields<T>()>());
+
+		return changed;
+	}
+
+	/*!***********************************************************************
+	* @brief
+	*	Writes the delta of one object in a single pass. Room for the changed
+	*	bits is reserved up front and filled in at the end, nested deltas that
+	*	turn out empty are cut off again. Leaves are written with the encoding
+	*	their attributes in Root ask for, T's leaves start at leaf Base of Root.
+	*
+	* @return				: true if any data member changed.
+	**************************************************************************/
+	template <typename Root, std::size_t Base, typename Buffer, typename T>
+	bool _internal_serializeDelta(_internal_BinaryWriter<Buffer>& writer, T const& before, T const& after) {
+		constexpr std::size_t maskSize = (getNumberOfFields<T>() + 7) / 8;
+
+		std::size_t const maskPosition = writer.buffer.size();
+		std::array<std::byte, maskSize> mask {};
+		writer.reserve(maskSize);
+
+		[&]<std::size_t... ints>(std::index_sequence<ints...>) {
+			([&] {
+				using Field = typename query::FieldDataType<ints, T>::type;
+				constexpr std::size_t leaf = Base + _internal_leafStarts<T>[ints];
+				auto const& oldValue = before.*query::FieldDataType<ints, T>::getPointerToMember();
+				auto const& newValue = after.*query::FieldDataType<ints, T>::getPointerToMember();
+				bool changed = false;
+
+				if constexpr (isReflectable<Field>()) {
+					std::size_t const position = writer.buffer.size();
+					changed = _internal_serializeDelta<Root, leaf>(writer, oldValue, newValue);
+
+					if (!changed) {
+						writer.buffer.resize(position);
+					}
+				}
+				else if constexpr (!_internal_leaves<Root>[leaf].attributes.skip) {
+					if (!_internal_equal(oldValue, newValue)) {
+						_internal_serializeLeaf<Root, leaf>(writer, newValue);
+						changed = true;
+					}
+				}
+
+				if (changed) {
+					mask[ints / 8] |= std::byte{ 1 } << (ints % 8);
+				}
+			}(), ...);
+		}(std::make_index_sequence<getNumberOfFields<T>()>());
+
+		// the buffer may have grown since, so the mask is written through its position.
+		std::memcpy(reinterpret_cast<std::byte*>(writer.buffer.data()) + maskPosition, mask.data(), maskSize);
+
+		return std::ranges::any_of(mask, [](std::byte bits) { return bits != std::byte{ 0 }; });
+	}
+
+	template <typename Root, std::size_t Base, typename T>
+	void _internal_applyDelta(_internal_BinaryReader& reader, T& x) {
+		constexpr std::size_t maskSize = (getNumberOfFields<T>() + 7) / 8;
+
+		std::byte const* mask = reader.consume(maskSize);
+
+		if (!mask) {
+			return;
+		}
+
+		// bits past the last data member must be clear.
+		if constexpr (getNumberOfFields<T>() % 8 != 0) {
+			if ((mask[maskSize - 1] >> (getNumberOfFields<T>() % 8)) != std::byte{ 0 }) {
+				reader.failed = true;
+				return;
+			}
+		}
+
+		[&]<std::size_t... ints>(std::index_sequence<ints...>) {
+			([&] {
+				if (reader.failed || (mask[ints / 8] & (std::byte{ 1 } << (ints % 8))) == std::byte{ 0 }) {
+					return;
+				}
+
+				auto& value = x.*query::FieldDataType<ints, T>::getPointerToMember();
+				constexpr std::size_t leaf = Base + _internal_leafStarts<T>[ints];
+
+				if constexpr (isReflectable<typename query::FieldDataType<ints, T>::type>()) {
+					_internal_applyDelta<Root, leaf>(reader, value);
+				}
+				else if constexpr (_internal_leaves<Root>[leaf].attributes.skip) {
+					// never written, a delta claiming otherwise is malformed.
+					reader.failed = true;
+				}
+				else {
+					_internal_deserializeLeaf<Root, leaf>(reader, value);
+				}
+			}(), ...);
+		}(std::make_index_sequence<getNumberOfFields<T>()>());
+	}
+
+	template <typename T, ByteBuffer Buffer>
+	void serializeDelta(T const& before, T const& after, Buffer& buffer) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		_internal_BinaryWriter<Buffer> writer { buffer };
+		_internal_serializeDelta<T, 0>(writer, before, after);
+	}
+
+	template <typename T>
+	std::size_t applyDelta(std::span<const std::byte> bytes, T& x) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		_internal_BinaryReader reader { bytes };
+		_internal_applyDelta<T, 0>(reader, x);
+
+		return reader.failed ? 0 : reader.position;
+	}
+}
+
+/*!========================================================================
+	Parallel visit over ranges
+========================================================================*/
+namespace reflection {
+	// One call of ThreadExecutor::run, shared by every thread working on it.
+	struct _internal_ExecutorJob {
+		std::size_t count;
+		void (*invoke)(void* task, std::size_t index);
+		void* task;
+		std::atomic<std::size_t> next { 0 };
+		std::size_t workers = 0;	// worker threads inside work(), guarded by the executor's mutex.
+		std::exception_ptr error {};
+		std::mutex errorMutex {};
+
+		void work() {
+			for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;) {
+				try {
+					invoke(task, i);
+				}
+				catch (...) {
+					std::lock_guard lock { errorMutex };
+
+					if (!error) {
+						error = std::current_exception();
+					}
+
+					// skip the tasks nobody started yet.
+					next.store(count, std::memory_order_relaxed);
+				}
+			}
+		}
+	};
+
+	class ThreadExecutor {
+	public:
+		explicit ThreadExecutor(unsigned threads = std::thread::hardware_concurrency()) {
+			// the thread calling run works too.
+			unsigned const workerCount = threads > 1 ? threads - 1 : 0;
+			workers.reserve(workerCount);
+
+			try {
+				for (unsigned i = 0; i < workerCount; ++i) {
+					workers.emplace_back([this] { work(); });
+				}
+			}
+			catch (...) {
+				// threads that did start must be joined before the vector destroys them.
+				stop();
+				throw;
+			}
+		}
+
+		ThreadExecutor(ThreadExecutor const&) = delete;
+		ThreadExecutor& operator=(ThreadExecutor const&) = delete;
+
+		~ThreadExecutor() {
+			stop();
+		}
+
+		template <typename Task>
+		void run(std::size_t count, Task&& task) {
+			using Type = std::remove_reference_t<Task>;
+
+			_internal_ExecutorJob job { count, [](void* task, std::size_t index) { (*static_cast<Type*>(task))(index); }, const_cast<void*>(static_cast<void const*>(std::addressof(task))) };
+
+			if (count <= 1 || workers.empty()) {
+				job.work();
+			}
+			else {
+				std::lock_guard running { runMutex };
+
+				{
+					std::lock_guard lock { mutex };
+					current = &job;
+					++generation;
+				}
+
+				wake.notify_all();
+				job.work();
+
+				// workers that haven't picked the job up yet won't anymore, the ones inside it are waited for.
+				std::unique_lock lock { mutex };
+				current = nullptr;
+				finished.wait(lock, [&] { return job.workers == 0; });
+			}
+
+			if (job.error) {
+				std::rethrow_exception(job.error);
+			}
+		}
+
+	private:
+		void work() {
+			std::uint64_t seen = 0;
+			std::unique_lock lock { mutex };
+
+			while (true) {
+				wake.wait(lock, [&] { return stopping || (current && generation != seen); });
+
+				if (stopping) {
+					return;
+				}
+
+				seen = generation;
+				_internal_ExecutorJob& job = *current;
+				++job.workers;
+
+				lock.unlock();
+				job.work();
+				lock.lock();
+
+				if (--job.workers == 0) {
+					finished.notify_all();
+				}
+			}
+		}
+
+		void stop() {
+			{
+				std::lock_guard lock { mutex };
+				stopping = true;
+			}
+
+			wake.notify_all();
+
+			for (std::thread& thread : workers) {
+				thread.join();
+			}
+
+			workers.clear();
+		}
+
+		std::vector<std::thread> workers;
+		std::mutex runMutex;	// one run at a time, concurrent calls wait for each other.
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::condition_variable finished;
+		_internal_ExecutorJob* current = nullptr;
+		std::uint64_t generation = 0;
+		bool stopping = false;
+	};
+
+	template <typename Policy, typename Task>
+	void _internal_runTasks(Policy&& executor, std::size_t count, Task&& task) {
+#if defined(REFLECTION_EXECUTION_POLICIES)
+		if constexpr (std::is_execution_policy_v<std::remove_cvref_t<Policy>>) {
+			std::vector<std::size_t> tasks(count);
+
+			for (std::size_t i = 0; i < count; ++i) {
+				tasks[i] = i;
+			}
+
+			std::for_each(std::forward<Policy>(executor), tasks.begin(), tasks.end(), task);
+		}
+		else
+#endif
+		{
+			static_assert(Executor<std::remove_cvref_t<Policy>>, "Executor provided has no run(count, task) member function! Define REFLECTION_EXECUTION_POLICIES to use std::execution policies.");
+			executor.run(count, task);
+		}
+	}
+
+	// Elements per chunk, by default enough to fill about 16KiB so a chunk stays in the L1 cache.
+	template <typename Range>
+	std::size_t _internal_chunkSize(std::size_t chunkSize) {
+		return chunkSize ? chunkSize : std::max<std::size_t>(1, 16384 / sizeof(std::ranges::range_value_t<Range>));
+	}
+
+	template <typename Range>
+	std::size_t _internal_chunkCount(Range const& range, std::size_t chunkSize) {
+		return (static_cast<std::size_t>(std::ranges::distance(range)) + chunkSize - 1) / chunkSize;
+	}
+
+	// Splits range into chunks and runs task(chunkIndex, begin, end) for each of them.
+	template <typename Policy, typename Range, typename Task>
+	void _internal_forEachChunk(Policy&& executor, Range& range, std::size_t chunkSize, Task&& task) {
+		std::size_t const size = static_cast<std::size_t>(std::ranges::distance(range));
+		std::size_t const chunks = _internal_chunkCount(range, chunkSize);
+		auto const first = std::ranges::begin(range);
+
+		_internal_runTasks(std::forward<Policy>(executor), chunks, [&](std::size_t chunk) {
+			auto const begin = first + static_cast<std::ranges::range_difference_t<Range>>(chunk * chunkSize);
+			auto const end = first + static_cast<std::ranges::range_difference_t<Range>>(std::min(size, (chunk + 1) * chunkSize));
+
+			task(chunk, begin, end);
+		});
+	}
+
+	template <typename Policy, std::ranges::random_access_range Range, typename Functor>
+	void visitRange(Policy&& executor, Range&& range, Functor func, std::size_t chunkSize) {
+		static_assert(isReflectable<std::ranges::range_value_t<Range>>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		_internal_forEachChunk(std::forward<Policy>(executor), range, _internal_chunkSize<Range>(chunkSize), [&](std::size_t, auto begin, auto end) {
+			for (; begin != end; ++begin) {
+				visit(func, *begin);
+			}
+		});
+	}
+
+	template <typename Policy, std::ranges::random_access_range Range, ByteBuffer Buffer>
+	void serializeRange(Policy&& executor, Range const& range, Buffer& buffer, std::size_t chunkSize) {
+		static_assert(isReflectable<std::ranges::range_value_t<Range>>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		chunkSize = _internal_chunkSize<Range>(chunkSize);
+		std::vector<std::vector<std::byte>> chunkBuffers(_internal_chunkCount(range, chunkSize));
+
+		// every chunk owns its buffer, so no locking is needed and the order is kept.
+		_internal_forEachChunk(std::forward<Policy>(executor), range, chunkSize, [&](std::size_t chunk, auto begin, auto end) {
+			_internal_BinaryWriter<std::vector<std::byte>> writer { chunkBuffers[chunk] };
+
+			for (; begin != end; ++begin) {
+				_internal_serializeObject(writer, *begin);
+			}
+		});
+
+		std::size_t total = 0;
+
+		for (std::vector<std::byte> const& chunkBuffer : chunkBuffers) {
+			total += chunkBuffer.size();
+		}
+
+		_internal_BinaryWriter<Buffer> writer { buffer };
+		std::byte* destination = writer.reserve(total);
+
+		for (std::vector<std::byte> const& chunkBuffer : chunkBuffers) {
+			if (!chunkBuffer.empty()) {
+				std::memcpy(destination, chunkBuffer.data(), chunkBuffer.size());
+				destination += chunkBuffer.size();
+			}
+		}
+	}
+}
+
+/*!========================================================================
+	Hashing and equality
+========================================================================*/
+namespace reflection {
+	// Hashes size bytes into hash, 32 bytes at a time through four independent lanes so the multiplications overlap.
+	inline std::uint64_t _internal_hashBytes(void const* data, std::size_t size, std::uint64_t hash) {
+		unsigned char const* bytes = static_cast<unsigned char const*>(data);
+		hash = _internal_mix(hash, size);
+
+		auto load = [](unsigned char const* source) {
+			std::uint64_t word;
+			std::memcpy(&word, source, sizeof(word));
+			return word;
+		};
+
+		if (size >= 32) {
+			std::uint64_t lanes[4] = { hash, hash + 1, hash + 2, hash + 3 };
+
+			for (; size >= 32; size -= 32, bytes += 32) {
+				for (std::size_t i = 0; i < 4; ++i) {
+					lanes[i] = _internal_mix(lanes[i], load(bytes + i * 8));
+				}
+			}
+
+			hash = _internal_mix(_internal_mix(lanes[0], lanes[1]), _internal_mix(lanes[2], lanes[3]));
+		}
+
+		for (; size >= 8; size -= 8, bytes += 8) {
+			hash = _internal_mix(hash, load(bytes));
+		}
+
+		if (size) {
+			std::uint64_t word = 0;
+			std::memcpy(&word, bytes, size);
+			hash = _internal_mix(hash, word);
+		}
+
+		return hash;
+	}
+
+	template <typename T>
+	std::uint64_t _internal_hashObject(T const& x, std::uint64_t hash);
+
+	template <typename T>
+	std::uint64_t _internal_hashValue(T const& value, std::uint64_t hash) {
+		if constexpr (isReflectable<T>()) {
+			return _internal_hashObject(value, hash);
+		}
+		else if constexpr (std::is_array_v<T>) {
+			for (auto const& element : value) {
+				hash = _internal_hashValue(element, hash);
+			}
+
+			return hash;
+		}
+		else if constexpr (std::is_floating_point_v<T>) {
+			// -0 == 0, so both must hash the same. long double has padding bytes, which double doesn't.
+			double const normalized = value == T{} ? 0.0 : static_cast<double>(value);
+			return _internal_hashBytes(&normalized, sizeof(normalized), hash);
+		}
+		else if constexpr (std::is_scalar_v<T> && std::has_unique_object_representations_v<T>) {
+			return _internal_hashBytes(std::addressof(value), sizeof(T), hash);
+		}
+		else if constexpr (std::convertible_to<T const&, std::string_view>) {
+			std::string_view const string { value };
+			return _internal_hashBytes(string.data(), string.size(), hash);
+		}
+		else if constexpr (_internal_pairLike<T>) {
+			return _internal_hashValue(value.second, _internal_hashValue(value.first, hash));
+		}
+		else if constexpr (std::ranges::input_range<T const> && requires { typename T::hasher; }) {
+			// unordered containers compare equal in any order, so element hashes are combined with a sum.
+			std::uint64_t sum = 0;
+
+			for (auto const& element : value) {
+				sum += _internal_hashValue(element, 0);
+			}
+
+			return _internal_mix(hash, sum + static_cast<std::uint64_t>(std::ranges::distance(value)));
+		}
+		else if constexpr (std::ranges::input_range<T const>) {
+			std::uint64_t count = 0;
+
+			for (auto const& element : value) {
+				hash = _internal_hashValue(element, hash);
+				++count;
+			}
+
+			return _internal_mix(hash, count);
+		}
+		else if constexpr (requires { std::hash<T>{}(value); }) {
+			return _internal_mix(hash, std::hash<T>{}(value));
+		}
+		else if constexpr (std::has_unique_object_representations_v<T>) {
+			return _internal_hashBytes(std::addressof(value), sizeof(T), hash);
+		}
+		else {
+			static_assert(sizeof(T) == 0, "Data member cannot be hashed! It must be reflectable, arithmetic, a string, a range, a pair or have a std::hash specialization.");
+		}
+	}
+
+	template <typename T>
+	std::uint64_t _internal_hashObject(T const& x, std::uint64_t hash) {
+		_internal_visitLeaves(x, [&]<std::size_t I, typename U>(std::integral_constant<std::size_t, I>, U const& leaf) {
+			if constexpr (!_internal_leaves<T>[I].bitwise) {
+				hash = _internal_hashValue(leaf, hash);
+			}
+			else if constexpr (_internal_bitwiseRunSizes<T>[I] != 0) {
+				hash = _internal_hashBytes(std::addressof(leaf), _internal_bitwiseRunSizes<T>[I], hash);
+			}
+		});
+
+		return hash;
+	}
+
+	template <typename T>
+	bool equal(T const& a, T const& b) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		return _internal_allLeafPairs(a, b, [&]<std::size_t I, typename U>(std::integral_constant<std::size_t, I>, U const& left, U const& right) {
+			if constexpr (!_internal_leaves<T>[I].bitwise) {
+				return _internal_equal(left, right);
+			}
+			else if constexpr (_internal_bitwiseRunSizes<T>[I] != 0) {
+				return std::memcmp(std::addressof(left), std::addressof(right), _internal_bitwiseRunSizes<T>[I]) == 0;
+			}
+			else {
+				// compared as part of the run before.
+				return true;
+			}
+		});
+	}
+
+	template <typename T>
+	std::size_t hash(T const& x) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		return static_cast<std::size_t>(_internal_hashObject(x, 0));
+	}
+}
+
+/*!========================================================================
+	Layout report
+========================================================================*/
+namespace reflection {
+	template <typename T>
+	constexpr LayoutReport<getNumberOfFields<T>()> layoutReport() {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		constexpr std::size_t N = getNumberOfFields<T>();
+
+		LayoutReport<N> report {};
+		report.name = typeName<T>();
+		report.size = sizeof(T);
+		report.alignment = alignof(T);
+
+		std::array<FieldLayout, N> fields = layout<T>();
+		std::ranges::sort(fields, {}, &FieldLayout::offset);
+
+		std::size_t end = 0;
+		std::size_t used = 0;
+
+		for (std::size_t i = 0; i < N; ++i) {
+			FieldLayout const& field = fields[i];
+			bool const straddles = field.size && field.offset / cacheLineSize != (field.offset + field.size - 1) / cacheLineSize;
+
+			report.fields[i] = { field, field.offset > end ? field.offset - end : 0, straddles };
+			report.straddling += straddles;
+
+			end = std::max(end, field.offset + field.size);
+			used += field.size;
+		}
+
+		report.tailPadding = sizeof(T) - end;
+		report.padding = sizeof(T) - used;
+
+		// decreasing alignment leaves no gaps, every size is a multiple of its alignment. stable_sort isn't constexpr, ties keep their offset order.
+		std::ranges::sort(fields, [](FieldLayout const& a, FieldLayout const& b) {
+			return a.alignment != b.alignment ? a.alignment > b.alignment : a.offset < b.offset;
+		});
+
+		std::size_t offset = 0;
+
+		for (std::size_t i = 0; i < N; ++i) {
+			offset = (offset + fields[i].alignment - 1) / fields[i].alignment * fields[i].alignment + fields[i].size;
+			report.suggestedOrder[i] = fields[i].name;
+		}
+
+		report.suggestedSize = (offset + alignof(T) - 1) / alignof(T) * alignof(T);
+
+		return report;
+	}
+
+	template <std::size_t N>
+	std::ostream& operator<<(std::ostream& stream, LayoutReport<N> const& report) {
+		stream << report.name << ": " << report.size << " bytes, alignment " << report.alignment << ", " << report.padding << " bytes of padding\n";
+
+		for (FieldReport const& field : report.fields) {
+			stream << "\t" << field.layout.name << ": offset " << field.layout.offset << ", size " << field.layout.size;
+
+			if (field.paddingBefore) {
+				stream << ", " << field.paddingBefore << " bytes of padding before";
+			}
+
+			if (field.straddlesCacheLine) {
+				stream << ", straddles a cache line";
+			}
+
+			stream << "\n";
+		}
+
+		if (report.tailPadding) {
+			stream << "\t" << report.tailPadding << " bytes of tail padding\n";
+		}
+
+		if (report.suggestedSize < report.size) {
+			stream << "\tReordering to";
+
+			for (std::size_t i = 0; i < N; ++i) {
+				stream << (i ? ", " : " ") << report.suggestedOrder[i];
+			}
+
+			stream << " takes " << report.suggestedSize << " bytes\n";
+		}
+
+		return stream;
+	}
+
+	template <typename T>
+	constexpr void assertNoPadding() {
+		static_assert(layoutReport<T>().padding == 0, "Class provided has padding! Print reflection::layoutReport<T>() to see where, and its suggestedOrder for an order with less padding.");
+	}
+}
+
+/*!========================================================================
+	Flattened leaves
+========================================================================*/
+namespace reflection {
+	template <std::size_t I, typename Object>
+	struct LeafField {
+		using type = std::remove_cvref_t<decltype(_internal_leafAt<I>(std::declval<Object&>()))>;
+
+		static constexpr std::size_t index = I;
+
+		Object&& self;
+
+		constexpr decltype(auto) get() const {
+			return _internal_leafAt<I>(static_cast<Object&&>(self));
+		}
+
+		static constexpr std::string_view name() {
+			return _internal_leafNames<std::remove_cvref_t<Object>>[I];
+		}
+
+		static constexpr std::size_t offset() {
+			return _internal_leaves<std::remove_cvref_t<Object>>[I].offset;
+		}
+
+		static constexpr FieldAttributes attributes() {
+			return _internal_leaves<std::remove_cvref_t<Object>>[I].attributes;
+		}
+	};
+
+	template <typename T>
+	constexpr std::array<FieldLayout, getNumberOfLeaves<T>()> flatFields() {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		using Type = std::remove_cvref_t<T>;
+
+		return []<std::size_t... leaves>(std::index_sequence<leaves...>) {
+			return std::array<FieldLayout, sizeof...(leaves)> {
+				FieldLayout {
+					LeafField<leaves, Type>::name(),
+					LeafField<leaves, Type>::offset(),
+					sizeof(typename LeafField<leaves, Type>::type),
+					alignof(typename LeafField<leaves, Type>::type),
+					typeId<typename LeafField<leaves, Type>::type>()
+				}...
+			};
+		}(std::make_index_sequence<getNumberOfLeaves<Type>()>());
+	}
+
+	template <typename Functor, typename T>
+	constexpr void visitLeaves(Functor&& func, T&& x) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		[&]<std::size_t... leaves>(std::index_sequence<leaves...>) {
+			(func(LeafField<leaves, T> { static_cast<T&&>(x) }), ...);
+		}(std::make_index_sequence<getNumberOfLeaves<T>()>());
+	}
+}
+
+/*!========================================================================
+	Versioned serialization
+========================================================================*/
+namespace reflection {
+	// Encodings change the bytes of a data member without changing its type, data members without any keep their old hashes.
+	constexpr std::uint64_t _internal_attributesHash(FieldAttributes attributes, std::uint64_t hash) {
+		if (!attributes.encoded()) {
+			return hash;
+		}
+
+		hash = _internal_mix(hash, (attributes.skip ? 1u : 0u) | (attributes.varint ? 2u : 0u) | (attributes.quantized ? 4u : 0u));
+		hash = _internal_mix(hash, attributes.fixedWidth);
+		hash = _internal_mix(hash, std::bit_cast<std::uint64_t>(attributes.minimum));
+		return _internal_mix(hash, std::bit_cast<std::uint64_t>(attributes.maximum));
+	}
+
+	template <typename T>
+	constexpr std::uint64_t _internal_schemaHash(std::uint64_t hash) {
+		if constexpr (isReflectable<T>()) {
+			hash = _internal_mix(hash, getNumberOfFields<T>());
+
+			[&]<std::size_t... ints>(std::index_sequence<ints...>) {
+				((hash = _internal_schemaHash<typename query::FieldDataType<ints, T>::type>(_internal_attributesHash(query::FieldDataType<ints, T>::attributes(), _internal_fnv1a(query::FieldDataType<ints, T>::name(), hash)))), ...);
+			}(std::make_index_sequence<getNumberOfFields<T>()>());
+
+			return hash;
+		}
+		else if constexpr (_internal_pairLike<T>) {
+			return _internal_schemaHash<typename T::second_type>(_internal_schemaHash<std::remove_const_t<typename T::first_type>>(hash));
+		}
+		else if constexpr (std::ranges::range<T const>) {
+			// the container's type name doesn't change when a reflectable element type does.
+			return _internal_schemaHash<std::remove_cvref_t<std::ranges::range_value_t<T const>>>(_internal_mix(hash, typeId<T>()));
+		}
+		else {
+			return _internal_mix(hash, typeId<T>());
+		}
+	}
+
+	template <typename T>
+	constexpr std::uint64_t schemaHash() {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		return _internal_schemaHash<std::remove_cvref_t<T>>(0);
+	}
+
+	/*!***********************************************************************
+	* @brief
+	*	Layout written by serializeVersioned, all native endian:
+	*	u64 schemaHash, u64 size of the table, then for every leaf a u64 type
+	*	hash, u64 size of the leaf in the payload, u16 name length and the name.
+	*	The payload follows, in the same format as serialize.
+	**************************************************************************/
+	struct _internal_VersionedLeaf {
+		std::string_view name;
+		std::uint64_t typeHash;
+		std::span<const std::byte> bytes;
+	};
+
+	template <typename T, ByteBuffer Buffer>
+	void serializeVersioned(T const& x, Buffer& buffer) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		constexpr std::uint64_t hash = schemaHash<T>();
+		constexpr std::size_t leafCount = getNumberOfLeaves<T>();
+
+		std::uint64_t tableSize = 0;
+
+		for (std::string_view const name : _internal_leafNames<T>) {
+			tableSize += sizeof(std::uint64_t) * 2 + sizeof(std::uint16_t) + name.size();
+		}
+
+		_internal_BinaryWriter<Buffer> writer { buffer };
+		writer.write(&hash, sizeof(hash));
+		writer.write(&tableSize, sizeof(tableSize));
+
+		// leaf sizes are only known after writing the payload, so they are filled in through their positions.
+		std::array<std::size_t, leafCount> sizePositions {};
+
+		_internal_visitLeaves(x, [&]<std::size_t I, typename U>(std::integral_constant<std::size_t, I>, U const&) {
+			constexpr std::uint64_t typeHash = _internal_attributesHash(_internal_leaves<T>[I].attributes, _internal_schemaHash<U>(0));
+			constexpr std::string_view name = _internal_leafNames<T>[I];
+			std::uint16_t const nameLength = static_cast<std::uint16_t>(name.size());
+
+			writer.write(&typeHash, sizeof(typeHash));
+			sizePositions[I] = buffer.size();
+			writer.reserve(sizeof(std::uint64_t));
+			writer.write(&nameLength, sizeof(nameLength));
+			writer.write(name.data(), name.size());
+		});
+
+		_internal_visitLeaves(x, [&]<std::size_t I, typename U>(std::integral_constant<std::size_t, I>, U const& leaf) {
+			std::size_t const start = buffer.size();
+			_internal_serializeLeaf<T, I>(writer, leaf);
+
+			std::uint64_t const size = buffer.size() - start;
+			std::memcpy(reinterpret_cast<std::byte*>(buffer.data()) + sizePositions[I], &size, sizeof(size));
+		});
+	}
+
+	template <typename T>
+	std::size_t deserializeVersioned(std::span<const std::byte> bytes, T& x) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		_internal_BinaryReader reader { bytes };
+		std::uint64_t hash = 0;
+		std::uint64_t tableSize = 0;
+
+		if (!reader.read(&hash, sizeof(hash)) || !reader.read(&tableSize, sizeof(tableSize)) || tableSize > reader.remaining()) {
+			return 0;
+		}
+
+		std::span<const std::byte> const table = bytes.subspan(reader.position, static_cast<std::size_t>(tableSize));
+		reader.position += static_cast<std::size_t>(tableSize);
+
+		// same schema, the payload is exactly what serialize writes.
+		if (hash == schemaHash<T>()) {
+			_internal_deserializeObject(reader, x);
+			return reader.failed ? 0 : reader.position;
+		}
+
+		std::vector<_internal_VersionedLeaf> leaves;
+		_internal_BinaryReader tableReader { table };
+
+		while (tableReader.remaining() && !tableReader.failed) {
+			_internal_VersionedLeaf leaf {};
+			std::uint64_t size = 0;
+			std::uint16_t nameLength = 0;
+
+			tableReader.read(&leaf.typeHash, sizeof(leaf.typeHash));
+			tableReader.read(&size, sizeof(size));
+			tableReader.read(&nameLength, sizeof(nameLength));
+
+			if (std::byte const* name = tableReader.consume(nameLength)) {
+				leaf.name = { reinterpret_cast<char const*>(name), nameLength };
+			}
+
+			if (size > reader.remaining()) {
+				return 0;
+			}
+
+			leaf.bytes = bytes.subspan(reader.position, static_cast<std::size_t>(size));
+			reader.position += static_cast<std::size_t>(size);
+			leaves.push_back(leaf);
+		}
+
+		if (tableReader.failed) {
+			return 0;
+		}
+
+		bool failed = false;
+
+		_internal_visitLeaves(x, [&]<std::size_t I, typename U>(std::integral_constant<std::size_t, I>, U& value) {
+			auto const found = std::ranges::find(leaves, _internal_leafNames<T>[I], &_internal_VersionedLeaf::name);
+
+			if (failed || found == leaves.end() || found->typeHash != _internal_attributesHash(_internal_leaves<T>[I].attributes, _internal_schemaHash<U>(0))) {
+				return;
+			}
+
+			_internal_BinaryReader leafReader { found->bytes };
+			_internal_deserializeLeaf<T, I>(leafReader, value);
+			failed = leafReader.failed || leafReader.remaining() != 0;
+		});
+
+		return failed ? 0 : reader.position;
+	}
+}
+
+/*!========================================================================
+	Memory mapped tables
+========================================================================*/
+#if defined(REFLECTION_MMAP)
+namespace reflection {
+	struct _internal_TableHeader {
+		char magic[8];
+		std::uint64_t schemaHash;
+		std::uint64_t recordSize;
+		std::uint64_t reserved;
+	};
+
+	inline constexpr char _internal_tableMagic[8] = { 'R', 'F', 'L', 'T', 'A', 'B', 'L', '1' };
+
+	template <typename T>
+	class MmapTable {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+		static_assert(_internal_isFixedSize<T>(), "MmapTable needs fixed size records! Every leaf of the class must be trivially copyable and without ATTR encodings.");
+
+	public:
+		static constexpr std::size_t recordSize = _internal_packedSize<T>();
+
+		MmapTable() = default;
+		MmapTable(MmapTable const&) = delete;
+		MmapTable& operator=(MmapTable const&) = delete;
+
+		MmapTable(MmapTable&& other) noexcept {
+			*this = std::move(other);
+		}
+
+		MmapTable& operator=(MmapTable&& other) noexcept {
+			if (this != &other) {
+				close();
+				file = std::exchange(other.file, -1);
+				mapping = std::exchange(other.mapping, nullptr);
+				mappedSize = std::exchange(other.mappedSize, 0);
+				count = std::exchange(other.count, 0);
+				writable = other.writable;
+			}
+
+			return *this;
+		}
+
+		~MmapTable() {
+			close();
+		}
+
+		/*!***********************************************************************
+		* @brief
+		*	Opens the table at path, creating it if writable and it doesn't exist.
+		*	A record left half written by a crash is cut off when writable.
+		*
+		* @return				: false if the file can't be opened or mapped, or was written for a different schema.
+		**************************************************************************/
+		bool open(char const* path, bool openWritable = true) {
+			close();
+			writable = openWritable;
+			file = ::open(path, writable ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+
+			if (file < 0) {
+				return false;
+			}
+
+			struct stat status {};
+
+			if (::fstat(file, &status) != 0) {
+				close();
+				return false;
+			}
+
+			std::size_t fileSize = static_cast<std::size_t>(status.st_size);
+
+			if (fileSize == 0 && writable) {
+				_internal_TableHeader header { {}, schemaHash<T>(), recordSize, 0 };
+				std::memcpy(header.magic, _internal_tableMagic, sizeof(header.magic));
+
+				if (!writeAll(&header, sizeof(header), 0)) {
+					close();
+					return false;
+				}
+
+				fileSize = sizeof(header);
+			}
+
+			_internal_TableHeader header {};
+
+			if (fileSize < sizeof(header) || ::pread(file, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header))
+				|| std::memcmp(header.magic, _internal_tableMagic, sizeof(header.magic)) != 0 || header.schemaHash != schemaHash<T>() || header.recordSize != recordSize) {
+				close();
+				return false;
+			}
+
+			count = (fileSize - sizeof(header)) / recordSize;
+
+			if (writable && fileSize != byteSize() && ::ftruncate(file, static_cast<off_t>(byteSize())) != 0) {
+				close();
+				return false;
+			}
+
+			if (!map(byteSize())) {
+				close();
+				return false;
+			}
+
+			return true;
+		}
+
+		void close() {
+			if (mapping) {
+				::munmap(mapping, mappedSize);
+			}
+
+			if (file >= 0) {
+				::close(file);
+			}
+
+			file = -1;
+			mapping = nullptr;
+			mappedSize = 0;
+			count = 0;
+		}
+
+		bool isOpen() const {
+			return file >= 0;
+		}
+
+		std::size_t size() const {
+			return count;
+		}
+
+		bool append(T const& x) {
+			return append(std::span<T const>{ &x, 1 });
+		}
+
+		// Appends every record with a single write. Views into the table are invalidated when the mapping has to grow.
+		bool append(std::span<T const> records) {
+			if (!isOpen() || !writable) {
+				return false;
+			}
+
+			scratch.clear();
+			_internal_BinaryWriter<std::vector<std::byte>> writer { scratch };
+
+			for (T const& record : records) {
+				_internal_serializeObject(writer, record);
+			}
+
+			if (!writeAll(scratch.data(), scratch.size(), byteSize())) {
+				return false;
+			}
+
+			std::size_t const newSize = byteSize() + scratch.size();
+
+			// pages past the end of the file are never touched, so the mapping can grow ahead of it and remap rarely.
+			if (newSize > mappedSize && !map(std::max(newSize, mappedSize * 2))) {
+				return false;
+			}
+
+			count += records.size();
+			return true;
+		}
+
+		// Flushes appended records to the storage device.
+		bool sync() const {
+			return isOpen() && ::fsync(file) == 0;
+		}
+
+		View<T> operator[](std::size_t index) const {
+			assert(index < count);
+			return View<T>{ std::span<const std::byte>{ static_cast<std::byte const*>(mapping) + sizeof(_internal_TableHeader) + index * recordSize, recordSize } };
+		}
+
+		T load(std::size_t index) const {
+			T x {};
+			deserialize((*this)[index].bytes(), x);
+			return x;
+		}
+
+		// Random access range of a View<T> for every record.
+		auto records() const {
+			return std::views::iota(std::size_t{ 0 }, count) | std::views::transform([this](std::size_t index) { return (*this)[index]; });
+		}
+
+	private:
+		std::size_t byteSize() const {
+			return sizeof(_internal_TableHeader) + count * recordSize;
+		}
+
+		bool writeAll(void const* source, std::size_t size, std::size_t offset) {
+			char const* bytes = static_cast<char const*>(source);
+
+			while (size) {
+				ssize_t const written = ::pwrite(file, bytes, size, static_cast<off_t>(offset));
+
+				if (written < 0) {
+					// interrupted by a signal before writing anything, try again.
+					if (errno == EINTR) {
+						continue;
+					}
+
+					return false;
+				}
+
+				bytes += written;
+				offset += static_cast<std::size_t>(written);
+				size -= static_cast<std::size_t>(written);
+			}
+
+			return true;
+		}
+
+		bool map(std::size_t size) {
+			void* const newMapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+
+			if (newMapping == MAP_FAILED) {
+				return false;
+			}
+
+			if (mapping) {
+				::munmap(mapping, mappedSize);
+			}
+
+			mapping = newMapping;
+			mappedSize = size;
+			return true;
+		}
+
+		int file = -1;
+		void* mapping = nullptr;
+		std::size_t mappedSize = 0;
+		std::size_t count = 0;
+		bool writable = false;
+		std::vector<std::byte> scratch;
+	};
+}
+#endif
+
+/*!========================================================================
+	Runtime registry
+========================================================================*/
+namespace reflection::registry {
+	template <typename U>
+	U* FieldDescriptor::as(void* object) const {
+		return typeId == reflection::typeId<U>() ? static_cast<U*>(address(object)) : nullptr;
+	}
+
+	template <typename U>
+	U const* FieldDescriptor::as(void const* object) const {
+		return as<U>(const_cast<void*>(object));
+	}
+
+	inline FieldDescriptor const* TypeDescriptor::field(std::string_view name) const {
+		std::size_t const index = findField(name);
+		return index < fields.size() ? &fields[index] : nullptr;
+	}
+
+	template <typename T, std::size_t N>
+	void* _internal_fieldAddress(void* object) {
+		// const data members are given out as well, writing to them through this pointer is undefined.
+		return const_cast<void*>(static_cast<void const*>(std::addressof(static_cast<T*>(object)->*query::FieldDataType<N, T>::getPointerToMember())));
+	}
+
+	template <typename T, std::size_t N>
+	void _internal_getField(void const* object, void* destination) {
+		*static_cast<typename query::FieldDataType<N, T>::type*>(destination) = static_cast<T const*>(object)->*query::FieldDataType<N, T>::getPointerToMember();
+	}
+
+	template <typename T, std::size_t N>
+	void _internal_setField(void* object, void const* source) {
+		static_cast<T*>(object)->*query::FieldDataType<N, T>::getPointerToMember() = *static_cast<typename query::FieldDataType<N, T>::type const*>(source);
+	}
+
+	template <typename T>
+	void _internal_construct(void* storage) {
+		std::construct_at(static_cast<T*>(storage));
+	}
+
+	template <typename T>
+	void _internal_destroy(void* object) {
+		std::destroy_at(static_cast<T*>(object));
+	}
+
+	template <typename T>
+	constexpr std::array<FieldDescriptor, getNumberOfFields<T>()> _internal_makeFieldDescriptors();
+
+	// Variable templates so every descriptor exists once per program, in read only memory.
+	template <typename T>
+	inline constexpr std::array<FieldDescriptor, getNumberOfFields<T>()> _internal_fieldDescriptors = _internal_makeFieldDescriptors<T>();
+
+	template <typename T>
+	constexpr TypeDescriptor _internal_makeTypeDescriptor() {
+		void (*construct)(void*) = nullptr;
+		void (*destroy)(void*) = nullptr;
+
+		if constexpr (std::is_default_constructible_v<T>) {
+			construct = &_internal_construct<T>;
+		}
+
+		if constexpr (std::is_destructible_v<T>) {
+			destroy = &_internal_destroy<T>;
+		}
+
+		return TypeDescriptor { typeName<T>(), reflection::typeId<T>(), sizeof(T), alignof(T), _internal_fieldDescriptors<T>, &findField<T>, construct, destroy };
+	}
+
+	template <typename T>
+	inline constexpr TypeDescriptor _internal_typeDescriptor = _internal_makeTypeDescriptor<T>();
+
+	template <typename T, std::size_t N>
+	constexpr FieldDescriptor _internal_makeFieldDescriptor() {
+		using Field = query::FieldDataType<N, T>;
+		using Member = std::remove_reference_t<decltype(std::declval<T&>().*Field::getPointerToMember())>;
+
+		TypeDescriptor const* type = nullptr;
+		if constexpr (isReflectable<typename Field::type>()) {
+			type = &_internal_typeDescriptor<typename Field::type>;
+		}
+
+		void (*get)(void const*, void*) = nullptr;
+		void (*set)(void*, void const*) = nullptr;
+		if constexpr (std::is_copy_assignable_v<Member>) {
+			get = &_internal_getField<T, N>;
+			set = &_internal_setField<T, N>;
+		}
+
+		return FieldDescriptor {
+			Field::name(),
+			Field::offset(),
+			sizeof(typename Field::type),
+			reflection::typeId<typename Field::type>(),
+			type,
+			&_internal_fieldAddress<T, N>,
+			get,
+			set
+		};
+	}
+
+	template <typename T>
+	constexpr std::array<FieldDescriptor, getNumberOfFields<T>()> _internal_makeFieldDescriptors() {
+		return []<std::size_t... ints>(std::index_sequence<ints...>) {
+			return std::array<FieldDescriptor, getNumberOfFields<T>()> { _internal_makeFieldDescriptor<T, ints>()... };
+		}(std::make_index_sequence<getNumberOfFields<T>()>());
+	}
+
+	template <typename T>
+	constexpr TypeDescriptor const& describe() {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		return _internal_typeDescriptor<std::remove_cvref_t<T>>;
+	}
+
+	// Immutable once published. slots is an open addressing table on the type id, a power of two in size and at most half full.
+	struct _internal_Table {
+		std::vector<TypeDescriptor const*> types;
+		std::vector<TypeDescriptor const*> slots;
+	};
+
+	struct _internal_Registry {
+		std::atomic<_internal_Table const*> current { nullptr };
+		std::mutex mutex;
+
+		// replaced tables are kept alive, a reader may still be probing them.
+		std::vector<std::unique_ptr<_internal_Table const>> tables;
+	};
+
+	inline _internal_Registry& _internal_registry() {
+		static _internal_Registry registry;
+		return registry;
+	}
+
+	// Returns false if a type with the same id is already in slots.
+	inline bool _internal_insert(std::vector<TypeDescriptor const*>& slots, TypeDescriptor const& type) {
+		std::size_t const mask = slots.size() - 1;
+
+		for (std::size_t i = type.typeId & mask;; i = (i + 1) & mask) {
+			if (!slots[i]) {
+				slots[i] = &type;
+				return true;
+			}
+
+			if (slots[i]->typeId == type.typeId) {
+				return false;
+			}
+		}
+	}
+
+	inline void _internal_collect(TypeDescriptor const& type, std::vector<TypeDescriptor const*>& types) {
+		types.push_back(&type);
+
+		for (FieldDescriptor const& field : type.fields) {
+			if (field.type) {
+				_internal_collect(*field.type, types);
+			}
+		}
+	}
+
+	template <typename... Ts>
+	void add() {
+		std::vector<TypeDescriptor const*> added;
+		(_internal_collect(describe<Ts>(), added), ...);
+
+		_internal_Registry& registry = _internal_registry();
+		std::lock_guard lock { registry.mutex };
+
+		_internal_Table const* current = registry.current.load(std::memory_order_relaxed);
+		auto table = std::make_unique<_internal_Table>();
+
+		if (current) {
+			table->types = current->types;
+		}
+
+		table->slots.resize(std::bit_ceil(std::max<std::size_t>(16, 2 * (table->types.size() + added.size()))));
+
+		for (TypeDescriptor const* type : table->types) {
+			_internal_insert(table->slots, *type);
+		}
+
+		std::size_t const previousCount = table->types.size();
+		for (TypeDescriptor const* type : added) {
+			if (_internal_insert(table->slots, *type)) {
+				table->types.push_back(type);
+			}
+		}
+
+		if (table->types.size() == previousCount) {
+			return;
+		}
+
+		registry.current.store(table.get(), std::memory_order_release);
+		registry.tables.push_back(std::move(table));
+	}
+
+	inline TypeDescriptor const* find(std::uint64_t typeId) {
+		_internal_Table const* table = _internal_registry().current.load(std::memory_order_acquire);
+
+		if (!table) {
+			return nullptr;
+		}
+
+		std::size_t const mask = table->slots.size() - 1;
+
+		for (std::size_t i = typeId & mask;; i = (i + 1) & mask) {
+			TypeDescriptor const* type = table->slots[i];
+
+			if (!type || type->typeId == typeId) {
+				return type;
+			}
+		}
+	}
+
+	inline TypeDescriptor const* find(std::string_view typeName) {
+		TypeDescriptor const* type = find(_internal_fnv1a(typeName));
+		return type && type->name == typeName ? type : nullptr;
+	}
+
+	inline std::span<TypeDescriptor const* const> types() {
+		_internal_Table const* table = _internal_registry().current.load(std::memory_order_acquire);
+		return table ? std::span<TypeDescriptor const* const>{ table->types } : std::span<TypeDescriptor const* const>{};
+	}
+}
+
+/*!========================================================================
+	Columnar batches
+========================================================================*/
+namespace reflection {
+	template <typename T>
+	concept _internal_optional = requires { typename T::value_type; } && std::same_as<T, std::optional<typename T::value_type>>;
+
+	// Type of the values of a column, the leaf itself unless it is a std::optional.
+	template <typename T>
+	struct _internal_columnValue { using type = T; };
+
+	template <typename T>
+	struct _internal_columnValue<std::optional<T>> { using type = T; };
+
+	template <typename T>
+	concept _internal_stringColumn = std::convertible_to<T const&, std::string_view>;
+
+	// "w:" followed by the size of U, Arrow's fixed size binary.
+	template <typename U>
+	inline constexpr auto _internal_fixedBinaryFormat = [] {
+		std::array<char, 24> format { 'w', ':' };
+		std::size_t length = 2;
+
+		char digits[20] {};
+		std::size_t count = 0;
+		for (std::size_t size = sizeof(U); size != 0 || count == 0; size /= 10) {
+			digits[count++] = static_cast<char>('0' + size % 10);
+		}
+
+		while (count != 0) {
+			format[length++] = digits[--count];
+		}
+
+		return std::pair{ format, length };
+	}();
+
+	template <typename U>
+	constexpr std::string_view _internal_arrowFormat() {
+		if constexpr (_internal_optional<U>) {
+			return _internal_arrowFormat<typename U::value_type>();
+		}
+		else if constexpr (std::is_same_v<U, bool>) {
+			return "b";
+		}
+		else if constexpr (std::is_enum_v<U>) {
+			return _internal_arrowFormat<std::underlying_type_t<U>>();
+		}
+		else if constexpr (std::is_integral_v<U> && sizeof(U) <= 8) {
+			constexpr std::string_view formats[2][4] = { { "C", "S", "I", "L" }, { "c", "s", "i", "l" } };
+			return formats[std::is_signed_v<U>][std::countr_zero(sizeof(U))];
+		}
+		else if constexpr (std::is_same_v<U, float>) {
+			return "f";
+		}
+		else if constexpr (std::is_same_v<U, double>) {
+			return "g";
+		}
+		else if constexpr (_internal_stringColumn<U>) {
+			return "U";
+		}
+		else if constexpr (std::is_trivially_copyable_v<U>) {
+			return { _internal_fixedBinaryFormat<U>.first.data(), _internal_fixedBinaryFormat<U>.second };
+		}
+		else {
+			static_assert(sizeof(U) == 0, "Leaf cannot be stored in a column! It must be arithmetic, an enum, a string, trivially copyable or a std::optional of those.");
+		}
+	}
+
+	template <typename U>
+	void _internal_prepareColumn(Column& column, std::string_view name, std::size_t rows) {
+		using Value = typename _internal_columnValue<U>::type;
+
+		column.name = name;
+		column.format = _internal_arrowFormat<U>();
+		column.typeId = typeId<U>();
+		column.validity.assign((rows + 7) / 8, 0xff);
+
+		if constexpr (std::is_same_v<Value, bool>) {
+			column.values.resize((rows + 7) / 8);
+		}
+		else if constexpr (_internal_stringColumn<Value>) {
+			column.offsets.resize(rows + 1);
+		}
+		else {
+			column.values.resize(rows * sizeof(Value));
+		}
+	}
+
+	template <typename U>
+	void _internal_writeCell(Column& column, std::size_t row, U const& value) {
+		std::uint8_t const bit = static_cast<std::uint8_t>(1u << (row % 8));
+
+		if constexpr (_internal_optional<U>) {
+			if (value) {
+				_internal_writeCell(column, row, *value);
+				return;
+			}
+
+			column.validity[row / 8] &= static_cast<std::uint8_t>(~bit);
+			++column.nullCount;
+
+			if constexpr (_internal_stringColumn<typename U::value_type>) {
+				column.offsets[row + 1] = column.offsets[row];
+			}
+		}
+		else if constexpr (std::is_same_v<U, bool>) {
+			if (value) {
+				column.values[row / 8] |= static_cast<std::byte>(bit);
+			}
+		}
+		else if constexpr (_internal_stringColumn<U>) {
+			std::string_view const string = value;
+			std::byte const* characters = reinterpret_cast<std::byte const*>(string.data());
+
+			column.values.insert(column.values.end(), characters, characters + string.size());
+			column.offsets[row + 1] = static_cast<std::int64_t>(column.values.size());
+		}
+		else {
+			std::memcpy(column.values.data() + row * sizeof(U), std::addressof(value), sizeof(U));
+		}
+	}
+
+	template <typename U>
+	bool _internal_validColumn(Column const& column, std::string_view name, std::size_t rows) {
+		using Value = typename _internal_columnValue<U>::type;
+
+		if (column.name != name || column.typeId != typeId<U>() || (!column.validity.empty() && column.validity.size() < (rows + 7) / 8)) {
+			return false;
+		}
+
+		if constexpr (std::is_same_v<Value, bool>) {
+			return column.values.size() >= (rows + 7) / 8;
+		}
+		else if constexpr (_internal_stringColumn<Value>) {
+			return column.offsets.size() == rows + 1;
+		}
+		else {
+			return column.values.size() >= rows * sizeof(Value);
+		}
+	}
+
+	// Null rows leave value untouched unless it is a std::optional, which is reset.
+	template <typename U>
+	bool _internal_readCell(Column const& column, std::size_t row, U& value) {
+		bool const valid = column.validity.empty() || (column.validity[row / 8] >> (row % 8) & 1);
+
+		if constexpr (_internal_optional<U>) {
+			if (!valid) {
+				value.reset();
+				return true;
+			}
+
+			if (!value) {
+				value.emplace();
+			}
+
+			return _internal_readCell(column, row, *value);
+		}
+		else if (!valid) {
+			return true;
+		}
+		else if constexpr (std::is_same_v<U, bool>) {
+			value = (std::to_integer<unsigned>(column.values[row / 8]) >> (row % 8) & 1) != 0;
+		}
+		else if constexpr (_internal_stringColumn<U>) {
+			static_assert(requires(std::string_view string) { value.assign(string.data(), string.size()); }, "String leaf cannot be read from a column! It must own its characters, like std::string.");
+
+			std::int64_t const begin = column.offsets[row];
+			std::int64_t const end = column.offsets[row + 1];
+
+			if (begin < 0 || end < begin || static_cast<std::uint64_t>(end) > column.values.size()) {
+				return false;
+			}
+
+			value.assign(reinterpret_cast<char const*>(column.values.data()) + begin, static_cast<std::size_t>(end - begin));
+		}
+		else {
+			std::memcpy(std::addressof(value), column.values.data() + row * sizeof(U), sizeof(U));
+		}
+
+		return true;
+	}
+
+	template <typename T>
+	ColumnBatch toColumns(std::span<T const> rows) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		ColumnBatch batch { rows.size(), std::vector<Column>(getNumberOfLeaves<T>()) };
+
+		[&]<std::size_t... leaves>(std::index_sequence<leaves...>) {
+			(_internal_prepareColumn<TypeAt<leaves, LeafTypes<T>>>(batch.columns[leaves], _internal_leafNames<T>[leaves], rows.size()), ...);
+		}(std::make_index_sequence<getNumberOfLeaves<T>()>());
+
+		for (std::size_t row = 0; row < rows.size(); ++row) {
+			_internal_visitLeaves(rows[row], [&]<std::size_t I, typename U>(std::integral_constant<std::size_t, I>, U const& leaf) {
+				_internal_writeCell(batch.columns[I], row, leaf);
+			});
+		}
+
+		return batch;
+	}
+
+	template <typename T>
+	bool fromColumns(ColumnBatch const& batch, std::span<T> rows) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		if (rows.size() != batch.rows || batch.columns.size() != getNumberOfLeaves<T>()) {
+			return false;
+		}
+
+		bool const valid = [&]<std::size_t... leaves>(std::index_sequence<leaves...>) {
+			return (... && _internal_validColumn<TypeAt<leaves, LeafTypes<T>>>(batch.columns[leaves], _internal_leafNames<T>[leaves], rows.size()));
+		}(std::make_index_sequence<getNumberOfLeaves<T>()>());
+
+		if (!valid) {
+			return false;
+		}
+
+		bool succeeded = true;
+
+		for (std::size_t row = 0; row < rows.size() && succeeded; ++row) {
+			_internal_visitLeaves(rows[row], [&]<std::size_t I, typename U>(std::integral_constant<std::size_t, I>, U& leaf) {
+				succeeded = succeeded && _internal_readCell(batch.columns[I], row, leaf);
+			});
+		}
+
+		return succeeded;
+	}
+}
+
+/*!========================================================================
+	Streaming serialization
+========================================================================*/
+namespace reflection {
+	inline constexpr std::size_t _internal_streamChunkSize = 64 * 1024;
+
+	template <ByteSink Sink>
+	class StreamWriter {
+	public:
+		explicit StreamWriter(Sink sink, std::size_t chunkSize = _internal_streamChunkSize) : sink(std::move(sink)), chunkSize(std::max<std::size_t>(chunkSize, 1)) {
+			chunk.reserve(this->chunkSize);
+		}
+
+		StreamWriter(StreamWriter const&) = delete;
+		StreamWriter& operator=(StreamWriter const&) = delete;
+
+		~StreamWriter() {
+			flush();
+		}
+
+		// Appends x in the serialize format, sending every chunk that fills up. Returns false once the sink refused a chunk.
+		template <typename T>
+		bool write(T const& x) {
+			static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+			_internal_serializeObject(*this, x);
+			return !failed;
+		}
+
+		// Sends the partly filled chunk.
+		bool flush() {
+			if (!chunk.empty() && !failed) {
+				failed = !sink(std::span<const std::byte>{ chunk });
+			}
+
+			sent += chunk.size();
+			chunk.clear();
+			return !failed;
+		}
+
+		// Writer interface of the binary serializer.
+		std::byte* reserve(std::size_t size) {
+			if (chunk.size() + size > chunkSize) {
+				flush();
+			}
+
+			std::size_t const oldSize = chunk.size();
+			chunk.resize(oldSize + size);
+			return chunk.data() + oldSize;
+		}
+
+		void write(void const* source, std::size_t size) {
+			std::byte const* bytes = static_cast<std::byte const*>(source);
+
+			while (size) {
+				if (chunk.size() >= chunkSize) {
+					flush();
+				}
+
+				std::size_t const count = std::min(size, chunkSize - chunk.size());
+				chunk.insert(chunk.end(), bytes, bytes + count);
+				bytes += count;
+				size -= count;
+			}
+		}
+
+		// Bytes written so far.
+		std::uint64_t processed() const {
+			return sent + chunk.size();
+		}
+
+	private:
+		Sink sink;
+		std::size_t chunkSize;
+		std::vector<std::byte> chunk;
+		std::uint64_t sent = 0;
+		bool failed = false;
+	};
+
+	template <ByteSource Source>
+	class StreamReader {
+	public:
+		explicit StreamReader(Source source, std::size_t chunkSize = _internal_streamChunkSize) : source(std::move(source)), buffer(std::max<std::size_t>(chunkSize, 1)) {}
+
+		StreamReader(StreamReader const&) = delete;
+		StreamReader& operator=(StreamReader const&) = delete;
+
+		/*!***********************************************************************
+		* @brief
+		*	Reads the next object into x. Data members with polymorphic
+		*	allocators allocate from resource if it is given.
+		*
+		* @param [in] maxSize	: Most bytes the object may take, containers claiming more elements fail before allocating.
+		*
+		* @return				: false if the stream ended early or is malformed, the stream can't be read further then.
+		**************************************************************************/
+		template <typename T>
+		bool read(T& x, std::pmr::memory_resource* resource = nullptr, std::uint64_t maxSize = std::numeric_limits<std::uint64_t>::max()) {
+			static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+			if (failed) {
+				return false;
+			}
+
+			position = 0;
+			limit = maxSize;
+			this->resource = resource;
+
+			try {
+				_internal_deserializeObject(*this, x);
+			}
+			catch (std::bad_alloc const&) {
+				failed = true;
+			}
+
+			return !failed;
+		}
+
+		// Reader interface of the binary serializer, position counts the bytes of the current object.
+		std::size_t remaining() const {
+			return static_cast<std::size_t>(std::min<std::uint64_t>(limit - position, std::numeric_limits<std::size_t>::max()));
+		}
+
+		// Containers allocate at most a chunk ahead of the bytes they read, so a hostile element count can't allocate more than arrives.
+		std::size_t allocationLimit() const {
+			return std::min(remaining(), std::max(buffer.size(), end - begin));
+		}
+
+		std::uint64_t processed() const {
+			return position;
+		}
+
+		std::byte const* consume(std::size_t size) {
+			if (failed || size > remaining() || !fill(size)) {
+				failed = true;
+				return nullptr;
+			}
+
+			std::byte const* data = buffer.data() + begin;
+			begin += size;
+			position += size;
+			return data;
+		}
+
+		bool read(void* destination, std::size_t size) {
+			if (failed || size > remaining()) {
+				failed = true;
+				return false;
+			}
+
+			std::byte* bytes = static_cast<std::byte*>(destination);
+			position += size;
+
+			while (size) {
+				// large reads skip the chunk and go straight to the destination.
+				if (begin == end && size >= buffer.size()) {
+					std::size_t const count = source(std::span<std::byte>{ bytes, size });
+
+					if (count == 0 || count > size) {
+						failed = true;
+						return false;
+					}
+
+					bytes += count;
+					size -= count;
+					continue;
+				}
+
+				if (!fill(1)) {
+					failed = true;
+					return false;
+				}
+
+				std::size_t const count = std::min(size, end - begin);
+				std::memcpy(bytes, buffer.data() + begin, count);
+				begin += count;
+				bytes += count;
+				size -= count;
+			}
+
+			return true;
+		}
+
+		bool failed = false;
+		std::pmr::memory_resource* resource = nullptr;
+
+	private:
+		// Makes at least size bytes available from begin, growing the chunk only for fixed size objects larger than it.
+		bool fill(std::size_t size) {
+			if (end - begin >= size) {
+				return true;
+			}
+
+			std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+			end -= begin;
+			begin = 0;
+
+			if (buffer.size() < size) {
+				buffer.resize(size);
+			}
+
+			while (end < size) {
+				std::size_t const count = source(std::span<std::byte>{ buffer.data() + end, buffer.size() - end });
+
+				if (count == 0 || count > buffer.size() - end) {
+					return false;
+				}
+
+				end += count;
+			}
+
+			return true;
+		}
+
+		Source source;
+		std::vector<std::byte> buffer;
+		std::size_t begin = 0;
+		std::size_t end = 0;
+		std::uint64_t position = 0;
+		std::uint64_t limit = 0;
+	};
+}
+
+/*!========================================================================
+	Coroutine visit
+========================================================================*/
+namespace reflection {
+	class VisitTask {
+	public:
+		struct promise_type {
+			std::coroutine_handle<> continuation = std::noop_coroutine();
+			std::exception_ptr exception;
+
+			VisitTask get_return_object() noexcept {
+				return VisitTask { std::coroutine_handle<promise_type>::from_promise(*this) };
+			}
+
+			std::suspend_always initial_suspend() noexcept { return {}; }
+
+			auto final_suspend() noexcept {
+				struct Awaiter {
+					bool await_ready() noexcept { return false; }
+					std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept { return handle.promise().continuation; }
+					void await_resume() noexcept {}
+				};
+
+				return Awaiter {};
+			}
+
+			void return_void() noexcept {}
+			void unhandled_exception() noexcept { exception = std::current_exception(); }
+		};
+
+		VisitTask(VisitTask&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+
+		VisitTask& operator=(VisitTask&& other) noexcept {
+			if (this != &other) {
+				if (handle) {
+					handle.destroy();
+				}
+
+				handle = std::exchange(other.handle, {});
+			}
+
+			return *this;
+		}
+
+		~VisitTask() {
+			if (handle) {
+				handle.destroy();
+			}
+		}
+
+		bool await_ready() const noexcept {
+			return !handle || handle.done();
+		}
+
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+			handle.promise().continuation = awaiting;
+			return handle;
+		}
+
+		void await_resume() {
+			if (handle && handle.promise().exception) {
+				std::rethrow_exception(handle.promise().exception);
+			}
+		}
+
+		// Runs the task and blocks until it completed, rethrowing its exception.
+		void wait();
+
+	private:
+		explicit VisitTask(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+		std::coroutine_handle<promise_type> handle;
+	};
+
+	// Coroutine that starts right away and frees itself when done.
+	struct _internal_Detached {
+		struct promise_type {
+			_internal_Detached get_return_object() noexcept { return {}; }
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() noexcept {}
+			void unhandled_exception() noexcept { std::terminate(); }
+		};
+	};
+
+	inline void VisitTask::wait() {
+		std::mutex mutex;
+		std::condition_variable condition;
+		bool done = false;
+
+		[](VisitTask& task, std::mutex& mutex, std::condition_variable& condition, bool& done) -> _internal_Detached {
+			try {
+				co_await task;
+			}
+			catch (...) {}
+
+			// notified under the lock, so wait can't return and destroy them before this is done with them.
+			std::lock_guard lock { mutex };
+			done = true;
+			condition.notify_one();
+		}(*this, mutex, condition, done);
+
+		std::unique_lock lock { mutex };
+		condition.wait(lock, [&] { return done; });
+		await_resume();
+	}
+
+	// Data members in flight in a coVisit, finished from whichever thread completes their awaitable.
+	struct _internal_FanOut {
+		explicit _internal_FanOut(std::size_t limit) : limit(limit) {}
+
+		std::size_t limit;
+		std::mutex mutex;
+		std::size_t inFlight = 0;
+		std::size_t resumeBelow = 0;
+		std::coroutine_handle<> waiting;
+		std::exception_ptr exception;
+
+		// Suspends until fewer than count data members are in flight.
+		auto below(std::size_t count) {
+			struct Awaiter {
+				_internal_FanOut& state;
+				std::size_t count;
+
+				bool await_ready() {
+					std::lock_guard lock { state.mutex };
+					return state.inFlight < count;
+				}
+
+				bool await_suspend(std::coroutine_handle<> handle) {
+					std::lock_guard lock { state.mutex };
+
+					if (state.inFlight < count) {
+						return false;
+					}
+
+					state.waiting = handle;
+					state.resumeBelow = count;
+					return true;
+				}
+
+				void await_resume() noexcept {}
+			};
+
+			return Awaiter { *this, count };
+		}
+
+		void start() {
+			std::lock_guard lock { mutex };
+			++inFlight;
+		}
+
+		void fail(std::exception_ptr error) {
+			std::lock_guard lock { mutex };
+
+			if (!exception) {
+				exception = error;
+			}
+		}
+
+		// exception is written by whichever thread finishes an awaitable, other data members may still be in flight when it is read.
+		std::exception_ptr error() {
+			std::lock_guard lock { mutex };
+			return exception;
+		}
+
+		bool failed() {
+			return static_cast<bool>(error());
+		}
+
+		// Must be the last use of the state, resuming the visit may complete it and free the state.
+		void finish() {
+			std::coroutine_handle<> handle;
+
+			{
+				std::lock_guard lock { mutex };
+				--inFlight;
+
+				if (waiting && inFlight < resumeBelow) {
+					handle = std::exchange(waiting, {});
+				}
+			}
+
+			if (handle) {
+				handle.resume();
+			}
+		}
+	};
+
+	template <typename Awaitable>
+	_internal_Detached _internal_awaitField(_internal_FanOut& state, Awaitable awaitable) {
+		try {
+			co_await std::move(awaitable);
+		}
+		catch (...) {
+			state.fail(std::current_exception());
+		}
+
+		state.finish();
+	}
+
+	// FieldData of leaf Leaf of x, the same one visit hands to func.
+	template <std::size_t Leaf, typename T>
+	constexpr auto _internal_leafFieldData(T& x) {
+		using Type = std::remove_cvref_t<T>;
+		constexpr std::size_t field = _internal_leafFields<Type>[Leaf];
+		using Field = query::FieldDataType<field, Type>;
+
+		if constexpr (isReflectable<typename Field::type>()) {
+			return _internal_leafFieldData<Leaf - _internal_leafStarts<Type>[field]>(x.*Field::getPointerToMember());
+		}
+		else {
+			return query::getFieldData<field>(x);
+		}
+	}
+
+	template <std::size_t Leaf, typename Functor, typename T>
+	void _internal_startField(_internal_FanOut& state, Functor& func, T& x) {
+		try {
+			if constexpr (std::is_void_v<decltype(func(_internal_leafFieldData<Leaf>(x)))>) {
+				func(_internal_leafFieldData<Leaf>(x));
+			}
+			else {
+				auto awaitable = func(_internal_leafFieldData<Leaf>(x));
+				state.start();
+				_internal_awaitField(state, std::move(awaitable));
+			}
+		}
+		catch (...) {
+			state.fail(std::current_exception());
+		}
+	}
+
+	// Order in which visit invokes func for leaves and enterFunc and exitFunc for nested reflectable data members.
+	struct _internal_VisitEvent {
+		enum Kind : unsigned char { visitLeaf, enter, exit } kind;
+		std::size_t leaf;
+	};
+
+	template <typename T>
+	constexpr std::size_t _internal_visitEventCount() {
+		if constexpr (isReflectable<T>()) {
+			return []<std::size_t... ints>(std::index_sequence<ints...>) {
+				return (std::size_t{ 0 } + ... + (isReflectable<typename query::FieldDataType<ints, T>::type>()
+					? 2 + _internal_visitEventCount<typename query::FieldDataType<ints, T>::type>()
+					: 1));
+			}(std::make_index_sequence<getNumberOfFields<T>()>());
+		}
+		else {
+			return 0;
+		}
+	}
+
+	template <typename T, std::size_t Size>
+	constexpr void _internal_collectVisitEvents(std::array<_internal_VisitEvent, Size>& events, std::size_t& count, std::size_t& leaf) {
+		[&]<std::size_t... ints>(std::index_sequence<ints...>) {
+			([&] {
+				using Field = typename query::FieldDataType<ints, T>::type;
+
+				if constexpr (isReflectable<Field>()) {
+					events[count++] = { _internal_VisitEvent::enter, 0 };
+					_internal_collectVisitEvents<Field>(events, count, leaf);
+					events[count++] = { _internal_VisitEvent::exit, 0 };
+				}
+				else {
+					events[count++] = { _internal_VisitEvent::visitLeaf, leaf++ };
+				}
+			}(), ...);
+		}(std::make_index_sequence<getNumberOfFields<T>()>());
+	}
+
+	template <typename T>
+	inline constexpr auto _internal_visitEvents = [] {
+		std::array<_internal_VisitEvent, _internal_visitEventCount<T>()> events {};
+		std::size_t count = 0;
+		std::size_t leaf = 0;
+		_internal_collectVisitEvents<T>(events, count, leaf);
+		return events;
+	}();
+
+	template<typename Functor, typename Functor2, typename Functor3, typename T>
+	VisitTask coVisit(Functor func, Functor2 enterFunc, Functor3 exitFunc, T& x, std::size_t fanOut) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		using Starter = void (*)(_internal_FanOut&, Functor&, T&);
+
+		static constexpr auto starters = []<std::size_t... leaves>(std::index_sequence<leaves...>) {
+			return std::array<Starter, sizeof...(leaves)> { &_internal_startField<leaves, Functor, T>... };
+		}(std::make_index_sequence<getNumberOfLeaves<T>()>());
+
+		_internal_FanOut state { std::max<std::size_t>(fanOut, 1) };
+
+		for (_internal_VisitEvent const& event : _internal_visitEvents<std::remove_cv_t<T>>) {
+			if (event.kind == _internal_VisitEvent::visitLeaf) {
+				co_await state.below(state.limit);
+
+				if (!state.failed()) {
+					starters[event.leaf](state, func, x);
+				}
+				continue;
+			}
+
+			// data members of the previous object complete before entering or leaving a nested one.
+			co_await state.below(1);
+
+			if (state.failed()) {
+				break;
+			}
+
+			if (event.kind == _internal_VisitEvent::enter) {
+				enterFunc();
+			}
+			else {
+				exitFunc();
+			}
+		}
+
+		co_await state.below(1);
+
+		if (std::exception_ptr const error = state.error()) {
+			std::rethrow_exception(error);
+		}
+	}
+
+	template<typename Functor, typename T>
+	VisitTask coVisit(Functor func, T& x, std::size_t fanOut) {
+		return coVisit(std::move(func), []{}, []{}, x, fanOut);
+	}
+}
+
+/*!========================================================================
+	Assignment between reflectable classes
+========================================================================*/
+namespace reflection {
+	// Index in Source of the data member named like every data member of Destination, or getNumberOfFields<Source>() where there is none.
+	template <typename Destination, typename Source>
+	inline constexpr auto _internal_matchedFields = [] {
+		constexpr auto fields = layout<Destination>();
+
+		std::array<std::size_t, fields.size()> matches {};
+
+		for (std::size_t i = 0; i < fields.size(); ++i) {
+			matches[i] = indexOf<Source>(fields[i].name);
+		}
+
+		return matches;
+	}();
+
+	template <typename Destination, typename Source, std::size_t I>
+	constexpr bool _internal_sameTrivialField() {
+		constexpr std::size_t match = _internal_matchedFields<Destination, Source>[I];
+
+		if constexpr (match == static_cast<std::size_t>(getNumberOfFields<Source>())) {
+			return false;
+		}
+		else {
+			using Type = typename query::FieldDataType<I, Destination>::type;
+
+			return std::is_same_v<Type, typename query::FieldDataType<match, Source>::type> && std::is_trivially_copyable_v<Type>;
+		}
+	}
+
+	// Bytes covered by the matched data members, if they all have the same trivially copyable types and are contiguous in both classes.
+	struct _internal_AssignRun {
+		bool single = false;
+		std::size_t destinationOffset = 0;
+		std::size_t sourceOffset = 0;
+		std::size_t size = 0;
+	};
+
+	template <typename Destination, typename Source>
+	constexpr _internal_AssignRun _internal_assignRun() {
+		constexpr auto destinationFields = layout<Destination>();
+		constexpr auto sourceFields = layout<Source>();
+		constexpr auto const& matches = _internal_matchedFields<Destination, Source>;
+
+		constexpr auto same = []<std::size_t... ints>(std::index_sequence<ints...>) {
+			return std::array<bool, sizeof...(ints)> { _internal_sameTrivialField<Destination, Source, ints>()... };
+		}(std::make_index_sequence<destinationFields.size()>());
+
+		std::array<std::size_t, destinationFields.size()> order {};
+		std::size_t count = 0;
+
+		for (std::size_t i = 0; i < destinationFields.size(); ++i) {
+			if (matches[i] == sourceFields.size()) {
+				continue;
+			}
+
+			if (!same[i]) {
+				return {};
+			}
+
+			order[count++] = i;
+		}
+
+		if (count == 0) {
+			return {};
+		}
+
+		std::sort(order.begin(), order.begin() + count, [&](std::size_t a, std::size_t b) {
+			return destinationFields[a].offset < destinationFields[b].offset;
+		});
+
+		_internal_AssignRun run { true, destinationFields[order[0]].offset, sourceFields[matches[order[0]]].offset, 0 };
+
+		for (std::size_t k = 0; k < count; ++k) {
+			std::size_t const i = order[k];
+
+			if (destinationFields[i].offset != run.destinationOffset + run.size || sourceFields[matches[i]].offset != run.sourceOffset + run.size) {
+				return {};
+			}
+
+			run.size += destinationFields[i].size;
+		}
+
+		return run;
+	}
+
+	template <typename Destination, typename Source>
+	inline constexpr _internal_AssignRun _internal_assignRunOf = _internal_assignRun<Destination, Source>();
+
+	// Whether whole objects can be copied, every byte of both classes belongs to a matched data member at the same offset.
+	template <typename Destination, typename Source>
+	constexpr bool _internal_layoutIdentical() {
+		constexpr _internal_AssignRun run = _internal_assignRunOf<Destination, Source>;
+
+		if constexpr (sizeof(Destination) != sizeof(Source)) {
+			return false;
+		}
+		else {
+			return run.single && run.destinationOffset == 0 && run.sourceOffset == 0 && run.size == sizeof(Destination);
+		}
+	}
+
+	template <typename Destination, typename Source>
+	void _internal_assignValue(Destination& destination, Source const& source);
+
+	template <typename Destination, typename Source>
+	std::size_t _internal_assignElements(Destination& destination, Source const& source) {
+		if constexpr (requires { destination.resize(std::ranges::size(source)); }) {
+			destination.resize(std::ranges::size(source));
+		}
+
+		using DestinationElement = std::ranges::range_value_t<Destination>;
+		using SourceElement = std::ranges::range_value_t<Source const>;
+
+		std::size_t const count = std::min<std::size_t>(std::ranges::size(destination), std::ranges::size(source));
+
+		if constexpr (std::ranges::contiguous_range<Destination> && std::ranges::contiguous_range<Source const>
+			&& isReflectable<DestinationElement>() && isReflectable<SourceElement>()) {
+			if constexpr (_internal_layoutIdentical<DestinationElement, SourceElement>()) {
+				if (count) {
+					std::memcpy(std::ranges::data(destination), std::ranges::data(source), count * sizeof(DestinationElement));
+				}
+
+				return count;
+			}
+		}
+
+		auto destinationElement = std::ranges::begin(destination);
+		auto sourceElement = std::ranges::begin(source);
+
+		for (std::size_t i = 0; i < count; ++i, ++destinationElement, ++sourceElement) {
+			_internal_assignValue(*destinationElement, *sourceElement);
+		}
+
+		return count;
+	}
+
+	template <typename Destination, typename Source>
+	void _internal_assignValue(Destination& destination, Source const& source) {
+		if constexpr (std::is_same_v<Destination, Source> && !std::is_array_v<Destination>) {
+			destination = source;
+		}
+		else if constexpr (isReflectable<Destination>() && isReflectable<Source>()) {
+			assign(destination, source);
+		}
+		else if constexpr (std::is_assignable_v<Destination&, Source const&>) {
+			destination = source;
+		}
+		else if constexpr (std::is_constructible_v<Destination, Source const&>) {
+			destination = static_cast<Destination>(source);
+		}
+		else if constexpr (std::ranges::sized_range<Destination> && std::ranges::sized_range<Source const>) {
+			_internal_assignElements(destination, source);
+		}
+		else {
+			static_assert(sizeof(Destination) == 0, "Data members with the same name cannot be converted! Their types must be assignable, convertible, reflectable or ranges of such types.");
+		}
+	}
+
+	template <typename Destination, typename Source>
+	void assign(Destination& destination, Source const& source) {
+		static_assert(isReflectable<Destination>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+		static_assert(isReflectable<Source>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		constexpr _internal_AssignRun run = _internal_assignRunOf<Destination, Source>;
+
+		if constexpr (run.single) {
+			std::memcpy(reinterpret_cast<std::byte*>(std::addressof(destination)) + run.destinationOffset, reinterpret_cast<std::byte const*>(std::addressof(source)) + run.sourceOffset, run.size);
+		}
+		else {
+			[&]<std::size_t... ints>(std::index_sequence<ints...>) {
+				([&] {
+					constexpr std::size_t match = _internal_matchedFields<Destination, Source>[ints];
+
+					if constexpr (match != static_cast<std::size_t>(getNumberOfFields<Source>())) {
+						_internal_assignValue(Field<Destination, ints>::get(destination), Field<Source, match>::get(source));
+					}
+				}(), ...);
+			}(std::make_index_sequence<getNumberOfFields<Destination>()>());
+		}
+	}
+
+	template <std::ranges::random_access_range Destination, std::ranges::random_access_range Source>
+	std::size_t assignRange(Destination&& destination, Source const& source) {
+		static_assert(isReflectable<std::ranges::range_value_t<Destination>>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+		static_assert(isReflectable<std::ranges::range_value_t<Source const>>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		return _internal_assignElements(destination, source);
+	}
+}
+
+/*!========================================================================
+	Projections and filtered visits
+========================================================================*/
+namespace reflection {
+	template <typename T, FixedString... Names>
+	struct Projection {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+		static_assert(((indexOf<T>(Names.view()) < static_cast<std::size_t>(getNumberOfFields<T>())) && ...), "Class has no reflected data member with this name.");
+
+		// Invokes func with the FieldData of every chosen data member of x.
+		template <typename Functor, typename U>
+			requires std::same_as<std::remove_cvref_t<U>, T>
+		constexpr void visit(Functor&& func, U&& x) const {
+			(func(query::getFieldData<indexOf<T>(Names.view())>(static_cast<U&&>(x))), ...);
+		}
+
+		// Tuple of references to the chosen data members of x.
+		template <typename U>
+			requires std::same_as<std::remove_cvref_t<U>, T>
+		constexpr auto tie(U&& x) const {
+			return std::forward_as_tuple(Field<T, indexOf<T>(Names.view())>::get(static_cast<U&&>(x))...);
+		}
+
+		// Hash and equality of the chosen data members only, like hash and equal.
+		std::size_t hash(T const& x) const {
+			std::uint64_t seed = 0;
+			((seed = _internal_hashValue(Field<T, indexOf<T>(Names.view())>::get(x), seed)), ...);
+			return static_cast<std::size_t>(seed);
+		}
+
+		bool equal(T const& a, T const& b) const {
+			return (_internal_equal(Field<T, indexOf<T>(Names.view())>::get(a), Field<T, indexOf<T>(Names.view())>::get(b)) && ...);
+		}
+	};
+
+	template <typename T, FixedString... Names>
+	inline constexpr Projection<std::remove_cvref_t<T>, Names...> project {};
+
+	// Whether T is, or has a leaf that is, selected by Predicate.
+	template <typename T, template <typename> typename Predicate>
+	constexpr bool _internal_anySelected() {
+		if constexpr (isReflectable<T>()) {
+			return []<std::size_t... ints>(std::index_sequence<ints...>) {
+				return (false || ... || _internal_anySelected<typename query::FieldDataType<ints, T>::type, Predicate>());
+			}(std::make_index_sequence<getNumberOfFields<T>()>());
+		}
+		else {
+			return Predicate<T>::value;
+		}
+	}
+
+	template <std::size_t N>
+	struct _internal_Selection {
+		std::array<std::size_t, N> indices {};
+		std::size_t size = 0;
+	};
+
+	// Indices of the data members of T that visitIf visits or recurses into.
+	template <typename T, template <typename> typename Predicate>
+	inline constexpr auto _internal_selectedFields = [] {
+		_internal_Selection<getNumberOfFields<T>()> selection {};
+
+		[&]<std::size_t... ints>(std::index_sequence<ints...>) {
+			((_internal_anySelected<typename query::FieldDataType<ints, T>::type, Predicate>() ? void(selection.indices[selection.size++] = ints) : void()), ...);
+		}(std::make_index_sequence<getNumberOfFields<T>()>());
+
+		return selection;
+	}();
+
+	template <template <typename> typename Predicate, typename Functor, typename T>
+	constexpr void visitIf(Functor&& func, T&& x) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+
+		constexpr auto const& selection = _internal_selectedFields<std::remove_cvref_t<T>, Predicate>;
+
+		[&]<std::size_t... ints>(std::index_sequence<ints...>) {
+			([&] {
+				auto fieldData = query::getFieldData<selection.indices[ints]>(std::forward<T>(x));
+
+				if constexpr (isReflectable<typename decltype(fieldData)::type>()) {
+					visitIf<Predicate>(func, fieldData.get());
+				}
+				else {
+					func(fieldData);
+				}
+			}(), ...);
+		}(std::make_index_sequence<selection.size>());
+	}
+}
+
+/*!========================================================================
+	Object pool
+========================================================================*/
+namespace reflection {
+	// std::is_copy_assignable holds for containers of move only elements, so their elements are checked as well.
+	template <typename U>
+	constexpr bool _internal_copyAssignable() {
+		if constexpr (requires { typename U::value_type; }) {
+			using Element = std::remove_cv_t<typename U::value_type>;
+
+			if constexpr (!std::is_same_v<Element, U>) {
+				return std::is_copy_assignable_v<U> && std::is_copy_constructible_v<Element> && _internal_copyAssignable<Element>();
+			}
+		}
+
+		return std::is_copy_assignable_v<U>;
+	}
+
+	template <typename T>
+	void reset(T& x) {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+		static_assert(std::is_default_constructible_v<T>, "reset needs a default constructible class to take the values from.");
+
+		// never destroyed, like the pools calling reset, since objects may be released during static destruction.
+		static T const& defaults = *new T {};
+
+		// default constructed only for leaves that can't be copied from defaults.
+		std::optional<T> fresh;
+
+		_internal_visitLeaves(x, [&]<std::size_t I, typename U>(std::integral_constant<std::size_t, I>, U& leaf) {
+			auto const& defaultLeaf = _internal_leafAt<I>(defaults);
+
+			if constexpr (_internal_leaves<T>[I].trivial) {
+				if constexpr (_internal_runSizes<T>[I] != 0) {
+					std::memcpy(std::addressof(leaf), std::addressof(defaultLeaf), _internal_runSizes<T>[I]);
+				}
+			}
+			else if constexpr (requires { leaf.clear(); defaultLeaf.empty(); } && _internal_copyAssignable<U>()) {
+				if (defaultLeaf.empty()) {
+					leaf.clear();
+				}
+				else {
+					leaf = defaultLeaf;
+				}
+			}
+			else if constexpr (_internal_copyAssignable<U>()) {
+				leaf = defaultLeaf;
+			}
+			else if constexpr (std::is_move_assignable_v<U>) {
+				if constexpr (requires { leaf.clear(); defaultLeaf.empty(); }) {
+					if (defaultLeaf.empty()) {
+						leaf.clear();
+						return;
+					}
+				}
+
+				// the default may not be U {}, so it is taken from a default constructed T.
+				if (!fresh) {
+					fresh.emplace();
+				}
+
+				leaf = std::move(_internal_leafAt<I>(*fresh));
+			}
+			else {
+				static_assert(sizeof(U) == 0, "reset needs data members that are copy or move assignable.");
+			}
+		});
+	}
+
+	template <typename T>
+	class Pool {
+		static_assert(isReflectable<T>(), "Class provided is not reflectable! Did you forget to provide the REFLECTABLE macro?");
+		static_assert(std::is_default_constructible_v<T>, "Pool needs a default constructible class.");
+
+		// Header in front of every object, linking it into the shared list.
+		struct Node {
+			Node* next;
+		};
+
+		static constexpr std::size_t headerSize = (sizeof(Node) + alignof(T) - 1) / alignof(T) * alignof(T);
+		static constexpr std::align_val_t alignment { std::max(alignof(T), alignof(Node)) };
+		static constexpr std::size_t cacheSize = 64;
+
+		// Free list of a thread. spare holds the rest of the shared list taken by the last refill.
+		struct Cache {
+			std::array<T*, cacheSize> objects {};
+			std::size_t count = 0;
+			Node* spare = nullptr;
+
+			~Cache() {
+				Pool& shared = pool<T>();
+				shared.push(objects.data(), count);
+
+				if (spare) {
+					Node* last = spare;
+
+					while (last->next) {
+						last = last->next;
+					}
+
+					shared.pushChain(spare, last);
+				}
+			}
+		};
+
+	public:
+		struct Releaser {
+			void operator()(T* object) const {
+				pool<T>().release(object);
+			}
+		};
+
+		using Handle = std::unique_ptr<T, Releaser>;
+
+		Pool(Pool const&) = delete;
+		Pool& operator=(Pool const&) = delete;
+
+		// Reset object from this thread's free list, the shared list, or a newly constructed one.
+		Handle acquire() {
+			Cache& cache = threadCache();
+
+			if (cache.count) {
+				return Handle { cache.objects[--cache.count] };
+			}
+
+			if (!cache.spare) {
+				// taking the whole list can't suffer from ABA, unlike popping single nodes.
+				cache.spare = shared.exchange(nullptr, std::memory_order_acquire);
+			}
+
+			if (Node* node = cache.spare) {
+				cache.spare = node->next;
+				return Handle { objectOf(node) };
+			}
+
+			return Handle { create() };
+		}
+
+		// Resets object and keeps it for the next acquire. Handles call it when they are destroyed.
+		void release(T* object) {
+			if (!object) {
+				return;
+			}
+
+			// handles release from a noexcept destructor, an object that can't be reset is destroyed instead of terminating.
+			try {
+				reset(*object);
+			}
+			catch (...) {
+				destroy(object);
+				return;
+			}
+
+			Cache& cache = threadCache();
+
+			if (cache.count == cacheSize) {
+				// the oldest half goes to the shared list, so threads releasing more than they acquire feed the others.
+				push(cache.objects.data(), cacheSize / 2);
+				std::move(cache.objects.begin() + cacheSize / 2, cache.objects.end(), cache.objects.begin());
+				cache.count -= cacheSize / 2;
+			}
+
+			cache.objects[cache.count++] = object;
+		}
+
+		// Destroys the objects in the shared list. Objects in the free lists of threads are kept.
+		void trim() {
+			Node* node = shared.exchange(nullptr, std::memory_order_acquire);
+
+			while (node) {
+				Node* const next = node->next;
+				destroy(objectOf(node));
+				node = next;
+			}
+		}
+
+	private:
+		constexpr Pool() = default;
+
+		friend Pool& pool<T>();
+
+		static Node* nodeOf(T* object) {
+			return reinterpret_cast<Node*>(reinterpret_cast<std::byte*>(object) - headerSize);
+		}
+
+		static T* objectOf(Node* node) {
+			return std::launder(reinterpret_cast<T*>(reinterpret_cast<std::byte*>(node) + headerSize));
+		}
+
+		static T* create() {
+			std::byte* storage = static_cast<std::byte*>(::operator new(headerSize + sizeof(T), alignment));
+
+			try {
+				::new (storage) Node { nullptr };
+				return ::new (storage + headerSize) T {};
+			}
+			catch (...) {
+				::operator delete(storage, alignment);
+				throw;
+			}
+		}
+
+		static void destroy(T* object) {
+			Node* node = nodeOf(object);
+			object->~T();
+			::operator delete(static_cast<void*>(node), alignment);
+		}
+
+		static Cache& threadCache() {
+			thread_local Cache cache;
+			return cache;
+		}
+
+		void pushChain(Node* first, Node* last) {
+			last->next = shared.load(std::memory_order_relaxed);
+
+			while (!shared.compare_exchange_weak(last->next, first, std::memory_order_release, std::memory_order_relaxed)) {}
+		}
+
+		// Links objects into a chain and pushes it with a single compare exchange.
+		void push(T* const* objects, std::size_t count) {
+			if (count == 0) {
+				return;
+			}
+
+			Node* const first = nodeOf(objects[0]);
+			Node* last = first;
+
+			for (std::size_t i = 1; i < count; ++i) {
+				last->next = nodeOf(objects[i]);
+				last = last->next;
+			}
+
+			pushChain(first, last);
+		}
+
+		std::atomic<Node*> shared { nullptr };
+	};
+
+	// Never destroyed, threads return their free lists to it when they exit, which can be after static objects are destroyed.
+	template <typename T>
+	Pool<T>& pool() {
+		static constinit Pool<T> instance {};
+		return instance;
+	}
+}
+
+#endif
 #endif // CPP_REFLECTION_H
\ No newline at end of file